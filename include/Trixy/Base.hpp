@@ -46,6 +46,9 @@ struct TensorType
     struct vector {};
     struct matrix {};
     struct tensor {};
+
+    struct strided {};
+    struct batch {};
 };
 
 struct TensorMode
@@ -15,13 +15,16 @@
 #include <Trixy/Locker/Core.hpp>
 #include <Trixy/Require/Core.hpp>
 
+#include <Trixy/Memory/Core.hpp>
 #include <Trixy/Random/Core.hpp>
+#include <Trixy/Thread/Core.hpp>
+#include <Trixy/Distributed/Core.hpp>
 
 namespace trixy
 {
 
-// Special struct for types alias
-template <typename Precision>
+// Special struct for types alias, LinearBackend - lique::Linear or lique::ParallelLinear
+template <typename Precision, template <typename> class LinearBackend = lique::Linear>
 struct TypeSet
 {
     template <typename T>
@@ -30,8 +33,9 @@ struct TypeSet
     using Vector            = lique::Vector<Precision>;
     using Matrix            = lique::Matrix<Precision>;
     using Tensor            = lique::Tensor<Precision>;
+    using Batch             = lique::Batch<Precision>;
 
-    using Linear            = lique::Linear<Precision>;
+    using Linear            = LinearBackend<Precision>;
 
     using precision_type    = Precision;
     using size_type         = std::size_t;
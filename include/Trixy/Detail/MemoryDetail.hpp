@@ -0,0 +1,63 @@
+#ifndef TRIXY_MEMORY_DETAIL_HPP
+#define TRIXY_MEMORY_DETAIL_HPP
+
+#include <cstddef> // size_t
+#include <new> // placement new
+
+#include <Trixy/Memory/Base.hpp> // alignment, IAllocator
+
+namespace trixy
+{
+
+namespace detail
+{
+
+// Stored right before the data, so memory can be released without bound allocator
+struct AllocationHeader
+{
+    memory::IAllocator* owner;
+    std::size_t bytes;
+};
+
+constexpr std::size_t allocation_header_size
+    = (sizeof(AllocationHeader) + alignment - 1) / alignment * alignment;
+
+// Uninitialized aligned array of arithmetic types from allocator bound to current thread,
+// should be released by deallocate
+template <typename T>
+T* allocate(std::size_t size)
+{
+    auto& allocator = memory::current_allocator();
+
+    const std::size_t bytes = allocation_header_size + size * sizeof(T);
+    auto block = static_cast<char*>(allocator.allocate(bytes));
+
+    ::new (block + allocation_header_size - sizeof(AllocationHeader)) AllocationHeader{ &allocator, bytes };
+
+    return reinterpret_cast<T*>(block + allocation_header_size);
+}
+
+template <typename T>
+void deallocate(T* data) noexcept
+{
+    if (data == nullptr) return;
+
+    auto block = reinterpret_cast<char*>(data) - allocation_header_size;
+    auto header = reinterpret_cast<AllocationHeader*>(block + allocation_header_size - sizeof(AllocationHeader));
+
+    header->owner->deallocate(block, header->bytes);
+}
+
+// Number of elements in row of given width, that is padded up to the alignment
+template <typename T>
+constexpr std::size_t padded(std::size_t width) noexcept
+{
+    constexpr std::size_t step = alignment > sizeof(T) ? alignment / sizeof(T) : 1;
+    return (width + step - 1) / step * step;
+}
+
+} // namespace detail
+
+} // namespace trixy
+
+#endif // TRIXY_MEMORY_DETAIL_HPP
@@ -0,0 +1,63 @@
+#ifndef TRIXY_DISTRIBUTED_BASE_HPP
+#define TRIXY_DISTRIBUTED_BASE_HPP
+
+#include <cstddef> // size_t
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Collective communication between processes of one training job,
+// all processes (ranks) should call every collective operation in the same order
+class ICommunicator
+{
+public:
+    using size_type = std::size_t;
+
+public:
+    ICommunicator() = default;
+    virtual ~ICommunicator() = default;
+
+    ICommunicator(const ICommunicator&) = delete;
+    ICommunicator& operator= (const ICommunicator&) = delete;
+
+    virtual size_type rank() const noexcept = 0;
+    virtual size_type size() const noexcept = 0;
+
+    // false if connection between ranks was not established or was lost,
+    // result of collective operation that has lost connection is undefined
+    virtual bool is_open() const noexcept = 0;
+
+    // data = sum of data of all ranks, element-wise
+    virtual void allreduce(float* data, size_type size) noexcept = 0;
+    virtual void allreduce(double* data, size_type size) noexcept = 0;
+
+    // result = blocks of the same number of bytes of all ranks, in order of rank
+    virtual void allgather(const void* data, size_type bytes, void* result) noexcept = 0;
+
+    virtual void barrier() noexcept = 0;
+};
+
+namespace detail
+{
+
+// Bounds of i-th of n nearly equal chunks of range [0, size)
+inline std::size_t chunk_first(std::size_t i, std::size_t n, std::size_t size) noexcept
+{
+    return i * size / n;
+}
+
+inline std::size_t chunk_last(std::size_t i, std::size_t n, std::size_t size) noexcept
+{
+    return (i + 1) * size / n;
+}
+
+} // namespace detail
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_BASE_HPP
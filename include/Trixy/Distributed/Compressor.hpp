@@ -0,0 +1,193 @@
+#ifndef TRIXY_DISTRIBUTED_COMPRESSOR_HPP
+#define TRIXY_DISTRIBUTED_COMPRESSOR_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, int8_t, uint8_t
+#include <cstring> // memcpy, memset
+#include <cmath> // fabs, lround
+#include <algorithm> // nth_element
+#include <numeric> // iota
+#include <vector> // vector
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Lossy encoding of gradients before exchange between processes,
+// payload has fixed size for given size of data, so payloads of all ranks may be gathered at once
+template <typename T>
+class ICompressor
+{
+public:
+    using size_type = std::size_t;
+
+public:
+    virtual ~ICompressor() = default;
+
+    // bytes of payload for data of given size
+    virtual size_type capacity(size_type size) const noexcept = 0;
+
+    // Prepares internal buffers for data up to given size, should be called before compress of such data
+    virtual void reserve(size_type /*size*/) { /*pass*/ }
+
+    virtual void compress(const T* data, size_type size, char* payload) noexcept = 0;
+
+    // result += decoded payload
+    virtual void decompress(const char* payload, size_type size, T* result) const noexcept = 0;
+};
+
+// k largest by magnitude elements with their indices, the others are dropped
+template <typename T>
+class TopKCompressor : public ICompressor<T>
+{
+public:
+    using typename ICompressor<T>::size_type;
+
+private:
+    using index_type = std::uint32_t;
+
+private:
+    double ratio_;
+    std::vector<index_type> indices_;
+
+public:
+    // ratio - fraction of elements to keep
+    explicit TopKCompressor(double ratio = 0.01) : ratio_(ratio) {}
+
+    size_type capacity(size_type size) const noexcept override
+    {
+        return count(size) * (sizeof(index_type) + sizeof(T));
+    }
+
+    void reserve(size_type size) override
+    {
+        if (indices_.size() < size) indices_.resize(size);
+    }
+
+    // size should not exceed the last reserved size
+    void compress(const T* data, size_type size, char* payload) noexcept override
+    {
+        const size_type k = count(size);
+        if (k == 0) return;
+
+        const auto last = indices_.begin() + size;
+        std::iota(indices_.begin(), last, index_type(0));
+
+        std::nth_element(indices_.begin(), indices_.begin() + (k - 1), last,
+                         [data](index_type lhs, index_type rhs)
+                         { return std::fabs(data[lhs]) > std::fabs(data[rhs]); });
+
+        for (size_type i = 0; i < k; ++i, payload += sizeof(index_type) + sizeof(T))
+        {
+            std::memcpy(payload, &indices_[i], sizeof(index_type));
+            std::memcpy(payload + sizeof(index_type), data + indices_[i], sizeof(T));
+        }
+    }
+
+    void decompress(const char* payload, size_type size, T* result) const noexcept override
+    {
+        const size_type k = count(size);
+
+        index_type index;
+        T value;
+
+        for (size_type i = 0; i < k; ++i, payload += sizeof(index_type) + sizeof(T))
+        {
+            std::memcpy(&index, payload, sizeof(index_type));
+            std::memcpy(&value, payload + sizeof(index_type), sizeof(T));
+
+            result[index] += value;
+        }
+    }
+
+private:
+    size_type count(size_type size) const noexcept
+    {
+        const size_type k = static_cast<size_type>(ratio_ * static_cast<double>(size));
+        return k == 0 ? (size > 0 ? 1 : 0) : (k < size ? k : size);
+    }
+};
+
+// Element is rounded to one of 255 levels of [-max, max], max is the scale of data
+template <typename T>
+class Int8Compressor : public ICompressor<T>
+{
+public:
+    using typename ICompressor<T>::size_type;
+
+public:
+    size_type capacity(size_type size) const noexcept override
+    {
+        return sizeof(T) + size;
+    }
+
+    void compress(const T* data, size_type size, char* payload) noexcept override
+    {
+        T scale = 0;
+        for (size_type i = 0; i < size; ++i)
+            if (std::fabs(data[i]) > scale) scale = std::fabs(data[i]);
+
+        scale /= T(127);
+        std::memcpy(payload, &scale, sizeof(T));
+
+        auto levels = reinterpret_cast<std::int8_t*>(payload + sizeof(T));
+        for (size_type i = 0; i < size; ++i)
+            levels[i] = scale == T(0) ? 0 : static_cast<std::int8_t>(std::lround(data[i] / scale));
+    }
+
+    void decompress(const char* payload, size_type size, T* result) const noexcept override
+    {
+        T scale;
+        std::memcpy(&scale, payload, sizeof(T));
+
+        auto levels = reinterpret_cast<const std::int8_t*>(payload + sizeof(T));
+        for (size_type i = 0; i < size; ++i) result[i] += scale * levels[i];
+    }
+};
+
+// Only sign of element is kept, magnitude is the mean magnitude of data
+template <typename T>
+class SignCompressor : public ICompressor<T>
+{
+public:
+    using typename ICompressor<T>::size_type;
+
+public:
+    size_type capacity(size_type size) const noexcept override
+    {
+        return sizeof(T) + (size + 7) / 8;
+    }
+
+    void compress(const T* data, size_type size, char* payload) noexcept override
+    {
+        T scale = 0;
+        for (size_type i = 0; i < size; ++i) scale += std::fabs(data[i]);
+
+        if (size > 0) scale /= static_cast<T>(size);
+        std::memcpy(payload, &scale, sizeof(T));
+
+        auto bits = reinterpret_cast<std::uint8_t*>(payload + sizeof(T));
+        std::memset(bits, 0, (size + 7) / 8);
+
+        for (size_type i = 0; i < size; ++i)
+            if (data[i] >= T(0)) bits[i / 8] |= std::uint8_t(1u << (i % 8));
+    }
+
+    void decompress(const char* payload, size_type size, T* result) const noexcept override
+    {
+        T scale;
+        std::memcpy(&scale, payload, sizeof(T));
+
+        auto bits = reinterpret_cast<const std::uint8_t*>(payload + sizeof(T));
+        for (size_type i = 0; i < size; ++i)
+            result[i] += (bits[i / 8] >> (i % 8)) & 1u ? scale : -scale;
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_COMPRESSOR_HPP
@@ -0,0 +1,15 @@
+#ifndef TRIXY_DISTRIBUTED_CORE_HPP
+#define TRIXY_DISTRIBUTED_CORE_HPP
+
+#include <Trixy/Distributed/Base.hpp>
+#include <Trixy/Distributed/Compressor.hpp>
+#include <Trixy/Distributed/Reducer.hpp>
+
+// transports between processes of the same host
+#if defined(__unix__) || defined(__APPLE__)
+    #include <Trixy/Distributed/SharedMemory.hpp>
+    #include <Trixy/Distributed/Socket.hpp>
+    #include <Trixy/Distributed/ParameterServer.hpp>
+#endif
+
+#endif // TRIXY_DISTRIBUTED_CORE_HPP
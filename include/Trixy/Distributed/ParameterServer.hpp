@@ -0,0 +1,202 @@
+#ifndef TRIXY_DISTRIBUTED_PARAMETER_SERVER_HPP
+#define TRIXY_DISTRIBUTED_PARAMETER_SERVER_HPP
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // memcpy
+#include <atomic> // atomic, atomic_thread_fence
+#include <new> // placement new
+#include <string> // string
+#include <thread> // yield
+
+#include <Trixy/Distributed/Segment.hpp>
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Asynchronous parameter server on the same host, over POSIX shared memory segment:
+// server publishes parameters under seqlock, so workers may pull them at any moment,
+// each worker pushes gradients to own mailbox, tagged with version of parameters they were computed from,
+// server creates segment and initialises it before workers attach,
+// server and all workers should pass the same name, number of workers and number of parameters
+template <typename T>
+class ParameterChannel
+{
+public:
+    using size_type     = std::size_t;
+    using version_type  = std::uint64_t;
+
+private:
+    struct Header
+    {
+        std::atomic<version_type> sequence; // odd while parameters are written
+        std::atomic<unsigned> attached;     // number of workers
+        std::atomic<unsigned> stopped;
+    };
+
+    struct Mailbox
+    {
+        std::atomic<unsigned> is_full;
+        version_type version;
+    };
+
+    static_assert(std::atomic<version_type>::is_always_lock_free, "Seqlock requires address-free atomic.");
+
+    static constexpr size_type header_size = 64;
+
+private:
+    bool is_server_;
+    size_type workers_;
+    size_type size_; // number of parameters
+
+    size_type mailbox_size_; // bytes
+
+    SharedSegment segment_;
+
+public:
+    // worker < workers - id of worker, workers - id of server,
+    // timeout_ms - how long worker waits for segment of server
+    ParameterChannel(const std::string& name, size_type worker, size_type workers, size_type size,
+                     int timeout_ms = 10000)
+        : is_server_(worker == workers), workers_(workers), size_(size)
+        , mailbox_size_(header_size + (size * sizeof(T) + header_size - 1) / header_size * header_size)
+        , segment_(name, header_size + mailbox_size_ + workers * mailbox_size_, is_server_, timeout_ms)
+    {
+        if (not segment_.is_open()) return;
+
+        if (is_server_)
+        {
+            ::new (segment_.data()) Header();
+            for (size_type k = 0; k < workers_; ++k) ::new (mailbox(k)) Mailbox();
+
+            segment_.ready();
+        }
+        else
+        {
+            header()->attached.fetch_add(1);
+        }
+    }
+
+    ~ParameterChannel()
+    {
+        // all workers have attached before the server started
+        if (segment_.is_open() and is_server_) segment_.unlink();
+    }
+
+    ParameterChannel(const ParameterChannel&) = delete;
+    ParameterChannel& operator= (const ParameterChannel&) = delete;
+
+    bool is_open() const noexcept { return segment_.is_open(); }
+
+    size_type workers() const noexcept { return workers_; }
+    size_type size() const noexcept { return size_; }
+
+    // Server:
+
+    void wait_workers() const noexcept
+    {
+        while (header()->attached.load() < workers_) std::this_thread::yield();
+    }
+
+    void publish(const T* parameters) noexcept
+    {
+        auto& sequence = header()->sequence;
+
+        sequence.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        std::memcpy(parameters_data(), parameters, size_ * sizeof(T));
+
+        sequence.fetch_add(1, std::memory_order_release);
+    }
+
+    // Gradients of worker if they were pushed, staleness - number of publications since its pull
+    const T* take(size_type worker, version_type& staleness) const noexcept
+    {
+        auto box = mailbox(worker);
+        if (box->is_full.load(std::memory_order_acquire) == 0) return nullptr;
+
+        staleness = (header()->sequence.load() - box->version) / 2;
+        return gradients_data(worker);
+    }
+
+    // Mailbox of worker may be reused after its gradients were taken
+    void release(size_type worker) noexcept
+    {
+        mailbox(worker)->is_full.store(0, std::memory_order_release);
+    }
+
+    void stop() noexcept { header()->stopped.store(1); }
+
+    // Worker:
+
+    bool is_stopped() const noexcept { return header()->stopped.load() != 0; }
+
+    // Consistent copy of the last published parameters, false if server has stopped
+    bool pull(T* parameters, version_type& version) const noexcept
+    {
+        auto& sequence = header()->sequence;
+
+        while (not is_stopped())
+        {
+            version = sequence.load(std::memory_order_acquire);
+            if (version == 0 or version % 2 == 1)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::memcpy(parameters, parameters_data(), size_ * sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == version) return true;
+        }
+
+        return false;
+    }
+
+    // Waits until previous gradients of worker are taken, false if server has stopped
+    bool push(size_type worker, const T* gradients, version_type version) noexcept
+    {
+        auto box = mailbox(worker);
+
+        while (box->is_full.load(std::memory_order_acquire) != 0)
+        {
+            if (is_stopped()) return false;
+            std::this_thread::yield();
+        }
+
+        std::memcpy(gradients_data(worker), gradients, size_ * sizeof(T));
+        box->version = version;
+
+        box->is_full.store(1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    Header* header() const noexcept { return reinterpret_cast<Header*>(segment_.data()); }
+
+    T* parameters_data() const noexcept
+    {
+        return reinterpret_cast<T*>(segment_.data() + header_size);
+    }
+
+    Mailbox* mailbox(size_type worker) const noexcept
+    {
+        return reinterpret_cast<Mailbox*>(segment_.data() + header_size + mailbox_size_ + worker * mailbox_size_);
+    }
+
+    T* gradients_data(size_type worker) const noexcept
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(mailbox(worker)) + header_size);
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_PARAMETER_SERVER_HPP
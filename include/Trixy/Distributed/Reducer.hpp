@@ -0,0 +1,233 @@
+#ifndef TRIXY_DISTRIBUTED_REDUCER_HPP
+#define TRIXY_DISTRIBUTED_REDUCER_HPP
+
+#include <cstddef> // size_t
+#include <algorithm> // copy, fill
+#include <atomic> // atomic
+#include <condition_variable> // condition_variable
+#include <mutex> // mutex, lock_guard, unique_lock
+#include <queue> // queue
+#include <thread> // thread
+#include <utility> // pair
+#include <vector> // vector
+
+#include <Trixy/Distributed/Base.hpp>
+#include <Trixy/Distributed/Compressor.hpp>
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Sums buffers of all ranks in background, so communication overlaps with computation:
+// buffers are packed into buckets of bucket_size elements, full bucket is reduced by communication thread
+// and unpacked back, buffers should not be touched until wait returns;
+// with compressor buckets are exchanged as payloads, error of compression is kept per bucket
+// and is added to the same bucket at the next step (error feedback)
+template <typename T>
+class Reducer
+{
+public:
+    using size_type = std::size_t;
+
+private:
+    struct Bucket
+    {
+        std::vector<T> data;
+        std::vector<std::pair<T*, size_type>> views; // destination of each packed buffer
+        size_type index = 0; // in order of flush since the last wait
+    };
+
+private:
+    ICommunicator& communicator_;
+    size_type bucket_size_;
+
+    ICompressor<T>* compressor_; // not owned
+
+    Bucket current_;
+    size_type next_index_ = 0;
+
+    // used by communication thread only
+    std::vector<std::vector<T>> residuals_;
+    std::vector<T> decoded_;
+    std::vector<char> payload_;
+    std::vector<char> gathered_;
+
+    std::atomic<size_type> bytes_{0};
+
+    std::queue<Bucket> pending_;
+    std::vector<Bucket> free_; // buckets with reserved storage
+    size_type in_flight_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::condition_variable done_;
+
+    bool is_stopped_ = false;
+
+    std::thread worker_;
+
+public:
+    explicit Reducer(ICommunicator& communicator,
+                     ICompressor<T>* compressor = nullptr,
+                     size_type bucket_size = size_type(1) << 18)
+        : communicator_(communicator), bucket_size_(bucket_size), compressor_(compressor)
+    {
+        worker_ = std::thread(&Reducer::work, this);
+    }
+
+    ~Reducer()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopped_ = true;
+        }
+
+        condition_.notify_one();
+        worker_.join();
+    }
+
+    Reducer(const Reducer&) = delete;
+    Reducer& operator= (const Reducer&) = delete;
+
+    ICommunicator& communicator() noexcept { return communicator_; }
+
+    // bytes sent by this rank to the exchange: buckets or their payloads
+    size_type bytes() const noexcept { return bytes_.load(); }
+
+    // Schedules buffer to reduce, bucket is sent as soon as it is full
+    void push(T* data, size_type size)
+    {
+        if (current_.data.size() + size > bucket_size_ and not current_.data.empty()) flush();
+
+        current_.data.insert(current_.data.end(), data, data + size);
+        current_.views.emplace_back(data, size);
+
+        if (current_.data.size() >= bucket_size_) flush();
+    }
+
+    // Sends partially filled bucket
+    void flush()
+    {
+        if (current_.views.empty()) return;
+
+        current_.index = next_index_++;
+
+        Bucket next;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            pending_.push(std::move(current_));
+            ++in_flight_;
+
+            if (not free_.empty())
+            {
+                next = std::move(free_.back());
+                free_.pop_back();
+            }
+        }
+
+        condition_.notify_one();
+
+        next.data.clear();
+        next.views.clear();
+
+        current_ = std::move(next);
+    }
+
+    // Blocks until all scheduled buffers are reduced
+    void wait()
+    {
+        flush();
+        next_index_ = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+
+private:
+    void work()
+    {
+        while (true)
+        {
+            Bucket bucket;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return is_stopped_ or not pending_.empty(); });
+
+                if (pending_.empty()) return;
+
+                bucket = std::move(pending_.front());
+                pending_.pop();
+            }
+
+            if (compressor_ == nullptr)
+            {
+                communicator_.allreduce(bucket.data.data(), bucket.data.size());
+                bytes_ += bucket.data.size() * sizeof(T);
+            }
+            else
+            {
+                compressing(bucket);
+            }
+
+            auto source = bucket.data.data();
+            for (auto& view : bucket.views)
+            {
+                std::copy(source, source + view.second, view.first);
+                source += view.second;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                free_.push_back(std::move(bucket));
+                --in_flight_;
+            }
+
+            done_.notify_all();
+        }
+    }
+
+    void compressing(Bucket& bucket)
+    {
+        T* data = bucket.data.data();
+        const size_type size = bucket.data.size();
+
+        if (residuals_.size() <= bucket.index) residuals_.resize(bucket.index + 1);
+
+        auto& residual = residuals_[bucket.index];
+        if (residual.size() != size) residual.assign(size, T(0));
+
+        for (size_type i = 0; i < size; ++i) data[i] += residual[i];
+
+        const size_type bytes = compressor_->capacity(size);
+
+        payload_.resize(bytes);
+        gathered_.resize(bytes * communicator_.size());
+
+        compressor_->reserve(size);
+        compressor_->compress(data, size, payload_.data());
+
+        // residual = data - decoded own payload
+        decoded_.assign(size, T(0));
+        compressor_->decompress(payload_.data(), size, decoded_.data());
+
+        for (size_type i = 0; i < size; ++i) residual[i] = data[i] - decoded_[i];
+
+        communicator_.allgather(payload_.data(), bytes, gathered_.data());
+        bytes_ += bytes;
+
+        std::fill(data, data + size, T(0));
+        for (size_type k = 0; k < communicator_.size(); ++k)
+            compressor_->decompress(gathered_.data() + k * bytes, size, data);
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_REDUCER_HPP
@@ -0,0 +1,146 @@
+#ifndef TRIXY_DISTRIBUTED_SEGMENT_HPP
+#define TRIXY_DISTRIBUTED_SEGMENT_HPP
+
+#include <cstddef> // size_t
+#include <cerrno> // errno, EPERM
+#include <atomic> // atomic
+#include <new> // placement new
+#include <string> // string
+#include <thread> // sleep_for
+#include <chrono> // milliseconds
+
+#include <fcntl.h> // O_CREAT, O_EXCL, O_RDWR
+#include <signal.h> // kill
+#include <sys/mman.h> // shm_open, shm_unlink, mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // ftruncate, close, getpid
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// POSIX shared memory segment of processes of one job: creator removes segment with the same name
+// that may be left by crashed run, creates new one and marks it ready once its data is initialised,
+// other processes map only ready segment of running creator and never resize it
+class SharedSegment
+{
+public:
+    using size_type = std::size_t;
+
+private:
+    // placed at the beginning of segment, before data
+    struct Control
+    {
+        std::atomic<unsigned> is_ready;
+        pid_t creator;
+    };
+
+    static_assert(std::atomic<unsigned>::is_always_lock_free, "Segment requires address-free atomic.");
+
+    static constexpr size_type control_size = 64;
+
+private:
+    std::string name_;
+
+    char* segment_;
+    size_type segment_size_;
+
+public:
+    // size - bytes of data, all processes should pass the same name and size
+    SharedSegment(const std::string& name, size_type size, bool is_creator, int timeout_ms = 10000)
+        : name_(name), segment_(nullptr), segment_size_(control_size + size)
+    {
+        if (is_creator) create(); else attach(timeout_ms);
+    }
+
+    ~SharedSegment()
+    {
+        if (segment_ != nullptr) ::munmap(segment_, segment_size_);
+    }
+
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator= (const SharedSegment&) = delete;
+
+    bool is_open() const noexcept { return segment_ != nullptr; }
+
+    // zero-filled for creator
+    char* data() const noexcept { return segment_ + control_size; }
+
+    // Creator: data is initialised, other processes may map segment
+    void ready() noexcept { control()->is_ready.store(1, std::memory_order_release); }
+
+    // Segment stays mapped by processes that have already opened it
+    void unlink() noexcept { ::shm_unlink(name_.c_str()); }
+
+private:
+    Control* control() const noexcept { return reinterpret_cast<Control*>(segment_); }
+
+    void create() noexcept
+    {
+        unlink();
+
+        int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return;
+
+        if (::ftruncate(fd, static_cast<off_t>(segment_size_)) == 0) map(fd);
+
+        ::close(fd);
+
+        if (segment_ == nullptr)
+        {
+            unlink();
+            return;
+        }
+
+        ::new (segment_) Control();
+        control()->creator = ::getpid();
+    }
+
+    void attach(int timeout_ms) noexcept
+    {
+        for (int elapsed = 0; elapsed < timeout_ms; elapsed += 1)
+        {
+            int fd = ::shm_open(name_.c_str(), O_RDWR, 0600);
+            if (fd >= 0)
+            {
+                // creator may have not resized segment yet
+                struct stat status;
+                if (::fstat(fd, &status) == 0 and static_cast<size_type>(status.st_size) >= segment_size_) map(fd);
+
+                ::close(fd);
+            }
+
+            if (segment_ != nullptr)
+            {
+                if (is_live()) return;
+
+                ::munmap(segment_, segment_size_);
+                segment_ = nullptr;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    // segment left by crashed run may be ready, but its creator no longer exists
+    bool is_live() const noexcept
+    {
+        if (control()->is_ready.load(std::memory_order_acquire) == 0) return false;
+
+        return ::kill(control()->creator, 0) == 0 or errno == EPERM;
+    }
+
+    void map(int fd) noexcept
+    {
+        void* segment = ::mmap(nullptr, segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (segment != MAP_FAILED) segment_ = static_cast<char*>(segment);
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_SEGMENT_HPP
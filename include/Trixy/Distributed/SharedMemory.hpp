@@ -0,0 +1,191 @@
+#ifndef TRIXY_DISTRIBUTED_SHARED_MEMORY_HPP
+#define TRIXY_DISTRIBUTED_SHARED_MEMORY_HPP
+
+#include <cstddef> // size_t
+#include <cstring> // memcpy
+#include <atomic> // atomic
+#include <new> // placement new
+#include <string> // string
+#include <thread> // yield
+#include <chrono> // steady_clock, milliseconds
+
+#include <Trixy/Distributed/Base.hpp>
+#include <Trixy/Distributed/Segment.hpp>
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Ranks on the same host exchange data through POSIX shared memory segment with one slot per rank,
+// allreduce is reduce-scatter followed by allgather: each rank sums own chunk of all slots,
+// then copies reduced chunks of other ranks, data bigger than slot is reduced piece by piece,
+// rank 0 creates segment and initialises it before the other ranks attach
+class SharedMemoryCommunicator : public ICommunicator
+{
+private:
+    // placed at the beginning of segment, initialised by rank 0
+    struct Header
+    {
+        std::atomic<unsigned> arrived;
+        std::atomic<unsigned> generation;
+    };
+
+    static_assert(std::atomic<unsigned>::is_always_lock_free, "Barrier requires address-free atomic.");
+
+    static constexpr size_type header_size = 64;
+
+private:
+    size_type rank_;
+    size_type size_;
+
+    size_type slot_size_; // bytes
+
+    int timeout_ms_;
+    bool is_failed_; // some rank has not arrived at barrier in time
+
+    SharedSegment segment_;
+
+public:
+    // name - unique name of segment, e.g. "/trixy-job", all ranks should pass the same name and slot_size,
+    // timeout_ms - how long rank waits for segment of rank 0 and for the other ranks at each barrier,
+    // so it should be longer than computation between collective operations of any rank; negative - no limit
+    SharedMemoryCommunicator(const std::string& name, size_type rank, size_type size,
+                             size_type slot_size = size_type(1) << 22, int timeout_ms = 10000)
+        : rank_(rank), size_(size), slot_size_(slot_size), timeout_ms_(timeout_ms), is_failed_(false)
+        , segment_(name, header_size + size * slot_size, rank == 0, timeout_ms)
+    {
+        if (not segment_.is_open()) return;
+
+        if (rank_ == 0)
+        {
+            ::new (segment_.data()) Header();
+            segment_.ready();
+        }
+
+        // no rank may unlink segment before all of them have opened it
+        barrier();
+    }
+
+    ~SharedMemoryCommunicator()
+    {
+        if (not segment_.is_open()) return;
+
+        barrier();
+        if (rank_ == 0) segment_.unlink();
+    }
+
+    size_type rank() const noexcept override { return rank_; }
+    size_type size() const noexcept override { return size_; }
+
+    bool is_open() const noexcept override { return segment_.is_open() and not is_failed_; }
+
+    void allreduce(float* data, size_type size) noexcept override { reduce(data, size); }
+    void allreduce(double* data, size_type size) noexcept override { reduce(data, size); }
+
+    void allgather(const void* data, size_type bytes, void* result) noexcept override
+    {
+        if (not is_open()) return;
+
+        auto source = static_cast<const char*>(data);
+        auto target = static_cast<char*>(result);
+
+        for (size_type offset = 0; offset < bytes; offset += slot_size_)
+        {
+            const size_type piece = bytes - offset < slot_size_ ? bytes - offset : slot_size_;
+
+            std::memcpy(slot<char>(rank_), source + offset, piece);
+            barrier();
+
+            for (size_type k = 0; k < size_; ++k)
+                std::memcpy(target + k * bytes + offset, slot<char>(k), piece);
+
+            barrier();
+        }
+    }
+
+    // rank that has waited for the others longer than timeout is closed, so is_open is false then
+    void barrier() noexcept override
+    {
+        if (not is_open()) return;
+
+        auto header = reinterpret_cast<Header*>(segment_.data());
+
+        const unsigned generation = header->generation.load();
+
+        if (header->arrived.fetch_add(1) + 1 == size_)
+        {
+            header->arrived.store(0);
+            header->generation.fetch_add(1);
+            return;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms_);
+
+        while (header->generation.load() == generation)
+        {
+            if (timeout_ms_ >= 0 and std::chrono::steady_clock::now() > deadline)
+            {
+                is_failed_ = true;
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    template <typename T>
+    T* slot(size_type k) const noexcept
+    {
+        return reinterpret_cast<T*>(segment_.data() + header_size + k * slot_size_);
+    }
+
+    template <typename T>
+    void reduce(T* data, size_type size) noexcept
+    {
+        if (not is_open()) return;
+
+        const size_type capacity = slot_size_ / sizeof(T);
+
+        for (size_type offset = 0; offset < size; offset += capacity)
+        {
+            const size_type piece = size - offset < capacity ? size - offset : capacity;
+
+            std::memcpy(slot<T>(rank_), data + offset, piece * sizeof(T));
+            barrier();
+
+            // own chunk of own slot is overwritten by sum, other ranks read only their chunks
+            const size_type first = detail::chunk_first(rank_, size_, piece);
+            const size_type last = detail::chunk_last(rank_, size_, piece);
+
+            T* result = slot<T>(rank_);
+            for (size_type k = 0; k < size_; ++k)
+            {
+                if (k == rank_) continue;
+
+                const T* source = slot<T>(k);
+                for (size_type i = first; i < last; ++i) result[i] += source[i];
+            }
+
+            barrier();
+
+            for (size_type k = 0; k < size_; ++k)
+            {
+                const size_type chunk = detail::chunk_first(k, size_, piece);
+                std::memcpy(data + offset + chunk, slot<T>(k) + chunk,
+                            (detail::chunk_last(k, size_, piece) - chunk) * sizeof(T));
+            }
+
+            // slots may be overwritten by the next piece only after all ranks have read them
+            barrier();
+        }
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_SHARED_MEMORY_HPP
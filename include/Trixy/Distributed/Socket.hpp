@@ -0,0 +1,259 @@
+#ifndef TRIXY_DISTRIBUTED_SOCKET_HPP
+#define TRIXY_DISTRIBUTED_SOCKET_HPP
+
+#include <cstddef> // size_t
+#include <cerrno> // errno, EAGAIN, EWOULDBLOCK, EINTR
+#include <cstring> // memcpy, memset, strncpy
+#include <string> // string, to_string
+#include <thread> // sleep_for
+#include <chrono> // milliseconds
+#include <vector> // vector
+
+#include <fcntl.h> // fcntl, O_NONBLOCK
+#include <poll.h> // poll
+#include <sys/socket.h> // socket, bind, listen, accept, connect, send, recv, setsockopt
+#include <sys/un.h> // sockaddr_un
+#include <unistd.h> // close, unlink
+
+#include <Trixy/Distributed/Base.hpp>
+
+namespace trixy
+{
+
+namespace distributed
+{
+
+// Ranks are connected in a ring by Unix domain sockets, rank k listens on "path.k",
+// allreduce is ring reduce-scatter followed by ring allgather, in 2 * (size - 1) steps,
+// each rank sends chunk to the next rank and receives chunk from the previous one at the same time
+class SocketCommunicator : public ICommunicator
+{
+private:
+#if defined(MSG_NOSIGNAL)
+    static constexpr int send_flags = MSG_NOSIGNAL;
+#else
+    static constexpr int send_flags = 0; // SO_NOSIGPIPE is set on socket instead, e.g. on macOS
+#endif
+
+private:
+    std::string path_;
+
+    size_type rank_;
+    size_type size_;
+
+    int timeout_ms_;
+
+    int next_; // sends to rank + 1
+    int prev_; // receives from rank - 1
+
+    std::vector<char> buffer_; // received chunk
+
+public:
+    // path - common prefix of socket files, e.g. "/tmp/trixy-job",
+    // timeout_ms - how long rank waits for its neighbours, both to connect and in each step of collective operation,
+    // so it should be longer than computation between collective operations of any rank; negative - no limit
+    SocketCommunicator(const std::string& path, size_type rank, size_type size,
+                       int timeout_ms = 10000)
+        : path_(path), rank_(rank), size_(size), timeout_ms_(timeout_ms), next_(-1), prev_(-1)
+    {
+        if (size_ < 2) return;
+
+        sockaddr_un self = address(rank_);
+        sockaddr_un next = address((rank_ + 1) % size_);
+
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) return;
+
+        ::unlink(self.sun_path);
+
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&self), sizeof(self)) == 0
+            and ::listen(listener, 1) == 0)
+        {
+            // the next rank may not listen yet
+            for (int elapsed = 0; timeout_ms < 0 or elapsed < timeout_ms; elapsed += 10)
+            {
+                next_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (::connect(next_, reinterpret_cast<sockaddr*>(&next), sizeof(next)) == 0) break;
+
+                ::close(next_);
+                next_ = -1;
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            // the previous rank may not have started at all
+            pollfd fd = { listener, POLLIN, 0 };
+            if (next_ >= 0 and wait(&fd, 1) > 0) prev_ = ::accept(listener, nullptr, nullptr);
+        }
+
+        ::close(listener);
+        ::unlink(self.sun_path);
+
+        if (not is_open())
+        {
+            close();
+            return;
+        }
+
+        ::fcntl(next_, F_SETFL, ::fcntl(next_, F_GETFL) | O_NONBLOCK);
+        ::fcntl(prev_, F_SETFL, ::fcntl(prev_, F_GETFL) | O_NONBLOCK);
+
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+        int on = 1;
+        ::setsockopt(next_, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    }
+
+    ~SocketCommunicator() { close(); }
+
+    size_type rank() const noexcept override { return rank_; }
+    size_type size() const noexcept override { return size_; }
+
+    bool is_open() const noexcept override { return size_ < 2 or (next_ >= 0 and prev_ >= 0); }
+
+    void allreduce(float* data, size_type size) noexcept override { reduce(data, size); }
+    void allreduce(double* data, size_type size) noexcept override { reduce(data, size); }
+
+    void allgather(const void* data, size_type bytes, void* result) noexcept override
+    {
+        auto target = static_cast<char*>(result);
+        std::memcpy(target + rank_ * bytes, data, bytes);
+
+        // block of rank - step is passed to the next rank
+        for (size_type step = 0; step + 1 < size_; ++step)
+        {
+            const size_type send = (rank_ + size_ - step) % size_;
+            const size_type recv = (rank_ + size_ - step - 1) % size_;
+
+            if (not exchange(target + send * bytes, bytes, target + recv * bytes, bytes)) return;
+        }
+    }
+
+    void barrier() noexcept override
+    {
+        // after size - 1 steps arrival of every rank has reached this one through the ring
+        char token = 0;
+        for (size_type step = 0; step + 1 < size_; ++step)
+            if (not exchange(&token, 1, &token, 1)) return;
+    }
+
+private:
+    sockaddr_un address(size_type rank) const noexcept
+    {
+        sockaddr_un result;
+        std::memset(&result, 0, sizeof(result));
+
+        result.sun_family = AF_UNIX;
+        std::strncpy(result.sun_path, (path_ + '.' + std::to_string(rank)).c_str(), sizeof(result.sun_path) - 1);
+
+        return result;
+    }
+
+    void close() noexcept
+    {
+        if (next_ >= 0) ::close(next_);
+        if (prev_ >= 0) ::close(prev_);
+
+        next_ = -1;
+        prev_ = -1;
+    }
+
+    // error of non-blocking call that does not mean loss of peer
+    static bool is_pending() noexcept
+    {
+        return errno == EAGAIN or errno == EWOULDBLOCK or errno == EINTR;
+    }
+
+    // poll bounded by timeout, interrupted poll is restarted with the whole timeout;
+    // returns number of ready descriptors, 0 on timeout or -1 on error
+    int wait(pollfd* fds, nfds_t count) const noexcept
+    {
+        int ready;
+        do ready = ::poll(fds, count, timeout_ms_ < 0 ? -1 : timeout_ms_);
+        while (ready < 0 and errno == EINTR);
+
+        return ready;
+    }
+
+    // Sends to the next rank and receives from the previous one, without deadlock on full socket buffers;
+    // returns false and closes communicator if peer is lost or stalls longer than timeout, so is_open is false then
+    bool exchange(const void* send, size_type send_size, void* recv, size_type recv_size) noexcept
+    {
+        if (not is_open()) return false;
+
+        auto out = static_cast<const char*>(send);
+        auto in = static_cast<char*>(recv);
+
+        while (send_size > 0 or recv_size > 0)
+        {
+            // finished direction is not polled, otherwise hang up of its peer would wake poll again and again
+            pollfd fds[2] = { { send_size > 0 ? next_ : -1, POLLOUT, 0 },
+                              { recv_size > 0 ? prev_ : -1, POLLIN, 0 } };
+
+            if (wait(fds, 2) <= 0) return fail();
+
+            if (fds[0].revents & (POLLOUT | POLLERR | POLLHUP))
+            {
+                auto sent = ::send(next_, out, send_size, send_flags);
+                if (sent < 0 and not is_pending()) return fail(); // peer is lost
+                if (sent > 0) { out += sent; send_size -= sent; }
+            }
+
+            if (fds[1].revents & (POLLIN | POLLERR | POLLHUP))
+            {
+                auto received = ::recv(prev_, in, recv_size, 0);
+                if (received == 0 or (received < 0 and not is_pending())) return fail(); // peer is lost
+                if (received > 0) { in += received; recv_size -= received; }
+            }
+        }
+
+        return true;
+    }
+
+    bool fail() noexcept
+    {
+        close();
+        return false;
+    }
+
+    template <typename T>
+    void reduce(T* data, size_type size) noexcept
+    {
+        if (size_ < 2) return;
+
+        buffer_.resize(((size + size_ - 1) / size_) * sizeof(T));
+        auto received = reinterpret_cast<T*>(buffer_.data());
+
+        auto first = [this, size](size_type k) { return detail::chunk_first(k % size_, size_, size); };
+        auto last = [this, size](size_type k) { return detail::chunk_last(k % size_, size_, size); };
+
+        // after step s rank holds sum of s + 2 ranks for chunk rank - s - 1
+        for (size_type step = 0; step + 1 < size_; ++step)
+        {
+            const size_type send = rank_ + size_ - step;
+            const size_type recv = rank_ + size_ - step - 1;
+
+            if (not exchange(data + first(send), (last(send) - first(send)) * sizeof(T),
+                             received, (last(recv) - first(recv)) * sizeof(T))) return;
+
+            T* result = data + first(recv);
+            for (size_type i = 0, n = last(recv) - first(recv); i < n; ++i) result[i] += received[i];
+        }
+
+        // rank holds fully reduced chunk rank + 1, it is passed around the ring
+        for (size_type step = 0; step + 1 < size_; ++step)
+        {
+            const size_type send = rank_ + 1 + size_ - step;
+            const size_type recv = rank_ + size_ - step;
+
+            if (not exchange(data + first(send), (last(send) - first(send)) * sizeof(T),
+                             data + first(recv), (last(recv) - first(recv)) * sizeof(T))) return;
+        }
+    }
+};
+
+} // namespace distributed
+
+} // namespace trixy
+
+#endif // TRIXY_DISTRIBUTED_SOCKET_HPP
@@ -0,0 +1,225 @@
+#ifndef TRIXY_LIQUE_BATCH_HPP
+#define TRIXY_LIQUE_BATCH_HPP
+
+#include <cstddef> // size_t
+
+#include <Trixy/Lique/Base.hpp>
+#include <Trixy/Lique/TensorBase.hpp>
+
+#include <Trixy/Lique/Matrix.hpp>
+#include <Trixy/Lique/Tensor.hpp>
+
+#include <Trixy/Lique/Shape.hpp>
+
+#include <Trixy/Lique/Detail/LiqueMeta.hpp>
+
+#include <Trixy/Serializer/Core.hpp>
+
+#include <Trixy/Detail/MetaMacro.hpp>
+#include <Trixy/Lique/Detail/MacroScope.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+// Batch of 3-D samples of the same shape in NCHW layout, one sample per row of matrix,
+// so it may be passed anywhere the matrix of samples is expected
+LIQUE_TENSOR_TEMPLATE()
+using Batch = Tensor<Precision, TensorType::batch, TensorMode::own>;
+
+LIQUE_TENSOR_TEMPLATE()
+class Tensor<Precision, TensorType::batch, TensorMode::own>
+    : public Matrix<Precision>
+    , public TensorType::batch
+{
+    SERIALIZATION_ACCESS()
+
+private:
+    using Base = Matrix<Precision>;
+
+public:
+    using typename Base::size_type;
+    using typename Base::precision_type;
+    using typename Base::value_type;
+    using typename Base::shape_type;
+
+    using batch_shape_type  = BatchShape<std::size_t>;
+
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+
+    using typename Base::reference;
+    using typename Base::const_reference;
+
+    using Base::at;
+    using Base::operator();
+
+protected:
+    shape_type sample_;
+
+public:
+    Tensor() noexcept = default;
+
+    explicit Tensor(const batch_shape_type& shape);
+    explicit Tensor(const batch_shape_type& shape, precision_type value);
+
+    Tensor(size_type batch, const shape_type& sample);
+    Tensor(size_type batch, const shape_type& sample, precision_type value);
+
+    // gathers samples of container, all of them should have the same shape
+    template <class Container>
+    explicit Tensor(const Container& samples);
+
+    size_type batch() const noexcept;
+
+    const shape_type& sample_shape() const noexcept;
+    batch_shape_type batch_shape() const noexcept;
+
+    TensorView<Precision> sample(size_type n) noexcept;
+    const TensorView<Precision> sample(size_type n) const noexcept;
+
+    pointer at(size_type n, size_type k, size_type i, size_type j) noexcept;
+    const_pointer at(size_type n, size_type k, size_type i, size_type j) const noexcept;
+
+    reference operator() (size_type n, size_type k, size_type i, size_type j) noexcept;
+    const_reference operator() (size_type n, size_type k, size_type i, size_type j) const noexcept;
+
+    Tensor& resize(const batch_shape_type& shape);
+    Tensor& resize(size_type batch, const shape_type& sample);
+
+    Tensor& reshape(size_type batch, const shape_type& sample) noexcept;
+};
+
+LIQUE_TENSOR_TEMPLATE()
+Batch<Precision>::Tensor(const batch_shape_type& shape)
+    : Tensor(shape.batch, shape.sample())
+{
+}
+
+LIQUE_TENSOR_TEMPLATE()
+Batch<Precision>::Tensor(const batch_shape_type& shape, precision_type value)
+    : Tensor(shape.batch, shape.sample(), value)
+{
+}
+
+LIQUE_TENSOR_TEMPLATE()
+Batch<Precision>::Tensor(size_type batch, const shape_type& sample)
+    : Base(batch, sample.size), sample_(sample)
+{
+}
+
+LIQUE_TENSOR_TEMPLATE()
+Batch<Precision>::Tensor(size_type batch, const shape_type& sample, precision_type value)
+    : Base(batch, sample.size, value), sample_(sample)
+{
+}
+
+LIQUE_TENSOR_TEMPLATE()
+template <class Container>
+Batch<Precision>::Tensor(const Container& samples)
+    : Tensor(samples.size(), samples.size() > 0 ? samples.front().shape() : shape_type())
+{
+    pointer row = this->data_;
+    for (const auto& sample : samples)
+    {
+        lique::detail::copy(row, row + sample_.size, sample.data());
+        row += sample_.size;
+    }
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::batch() const noexcept -> size_type
+{
+    return this->shape_.height;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::sample_shape() const noexcept -> const shape_type&
+{
+    return sample_;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::batch_shape() const noexcept -> batch_shape_type
+{
+    return batch_shape_type(this->shape_.height, sample_);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline TensorView<Precision> Batch<Precision>::sample(size_type n) noexcept
+{
+    return TensorView<Precision>(sample_, this->data_ + n * sample_.size);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline const TensorView<Precision> Batch<Precision>::sample(size_type n) const noexcept
+{
+    // view has no const specialization, constness is kept by return type
+    return TensorView<Precision>(sample_, this->data_ + n * sample_.size);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::at(size_type n, size_type k, size_type i, size_type j) noexcept -> pointer
+{
+    return this->data_ + n * sample_.size + (k * sample_.height + i) * sample_.width + j;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::at(size_type n, size_type k, size_type i, size_type j) const noexcept -> const_pointer
+{
+    return this->data_ + n * sample_.size + (k * sample_.height + i) * sample_.width + j;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::operator() (size_type n, size_type k, size_type i, size_type j) noexcept -> reference
+{
+    return *at(n, k, i, j); // dereferencing
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto Batch<Precision>::operator() (size_type n, size_type k, size_type i, size_type j) const noexcept -> const_reference
+{
+    return *at(n, k, i, j); // dereferencing
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto Batch<Precision>::resize(const batch_shape_type& shape) -> Tensor&
+{
+    return resize(shape.batch, shape.sample());
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto Batch<Precision>::resize(size_type batch, const shape_type& sample) -> Tensor&
+{
+    Base::resize(batch, sample.size);
+    sample_ = sample;
+
+    return *this;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto Batch<Precision>::reshape(size_type batch, const shape_type& sample) noexcept -> Tensor&
+{
+    // size of batch should not be changed
+    Base::reshape(batch, sample.size);
+    sample_ = sample;
+
+    return *this;
+}
+
+} // namespace lique
+
+} // namespace trixy
+
+// stored as matrix with one sample per row, followed by shape of sample,
+// so archive of batch may be loaded as plain matrix as well
+CONDITIONAL_SERIALIZATION(saveload, batch, trixy::lique::meta::is_batch<S>::value)
+{
+    using matrix = trixy::lique::Matrix<typename S::precision_type>;
+
+    archive & sf::base<matrix>(batch) & batch.sample_;
+}
+
+#endif // TRIXY_LIQUE_BATCH_HPP
@@ -7,8 +7,13 @@
 #include <Trixy/Lique/Vector.hpp>
 #include <Trixy/Lique/Matrix.hpp>
 #include <Trixy/Lique/Tensor.hpp>
+#include <Trixy/Lique/Batch.hpp>
 
+#include <Trixy/Lique/Strided.hpp>
+
+#include <Trixy/Lique/Lazy.hpp>
 #include <Trixy/Lique/Linear.hpp>
+#include <Trixy/Lique/ParallelLinear.hpp>
 
 #include <Trixy/Lique/Tool.hpp>
 
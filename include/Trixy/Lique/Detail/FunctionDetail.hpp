@@ -2,8 +2,12 @@
 #define TRIXY_LIQUE_FUNCTION_DETAIL_HPP
 
 #include <cstddef> // size_t
+#include <type_traits> // is_same
+
+#include <Trixy/Lique/Detail/KernelDetail.hpp>
 
 #include <Trixy/Detail/FunctionDetail.hpp>
+#include <Trixy/Detail/TrixyMeta.hpp>
 
 #include <Trixy/Detail/MetaMacro.hpp>
 
@@ -58,13 +62,22 @@ void copy(FwdIt first, FwdIt last, InIt src)
     while (first != last) *first++ = *src++;
 }
 
+template <typename T, typename U,
+          TRREQUIRE(std::is_same<T, trixy::meta::remove_cv<U>>::value and
+                    simd::is_vectorizable<T, cpy>::value)>
+void copy(T* first, T* last, U* src) noexcept
+{
+    simd::assign(first, last, cpy(), static_cast<const T*>(src));
+}
+
 template <typename FwdIt, typename Generator>
 void fill(FwdIt first, FwdIt last, Generator gen)
 {
     while(first != last) *first++ = gen();
 }
 
-template <typename T, class Operation>
+template <typename T, class Operation,
+          TRREQUIRE(not simd::is_vectorizable<T, Operation>::value)>
 void assign(T* first, T* last, Operation operation, const T& value)
 {
     while (first != last)
@@ -74,7 +87,8 @@ void assign(T* first, T* last, Operation operation, const T& value)
     }
 }
 
-template <typename T, class Operation>
+template <typename T, class Operation,
+          TRREQUIRE(not simd::is_vectorizable<T, Operation>::value)>
 void assign(T* first, T* last, Operation operation, const T* src)
 {
     while (first != last)
@@ -86,7 +100,8 @@ void assign(T* first, T* last, Operation operation, const T* src)
     }
 }
 
-template <typename T, class Operation>
+template <typename T, class Operation,
+          TRREQUIRE(not simd::is_vectorizable<T, Operation>::value)>
 void assign(T* first, T* last, Operation operation, const T& value, const T* rhs) // OVERIEW
 {
     while (first != last)
@@ -98,7 +113,8 @@ void assign(T* first, T* last, Operation operation, const T& value, const T* rhs
     }
 }
 
-template <typename T, class Operation>
+template <typename T, class Operation,
+          TRREQUIRE(not simd::is_vectorizable<T, Operation>::value)>
 void assign(T* first, T* last, Operation operation, const T* lhs, const T* rhs) // OVERVIEW
 {
     while (first != last)
@@ -111,6 +127,175 @@ void assign(T* first, T* last, Operation operation, const T* lhs, const T* rhs)
     }
 }
 
+template <typename T, class Operation,
+          TRREQUIRE(simd::is_vectorizable<T, Operation>::value)>
+void assign(T* first, T* last, Operation operation, const T& value) noexcept
+{
+    simd::assign(first, last, operation, value);
+}
+
+template <typename T, class Operation,
+          TRREQUIRE(simd::is_vectorizable<T, Operation>::value)>
+void assign(T* first, T* last, Operation operation, const T* src) noexcept
+{
+    simd::assign(first, last, operation, src);
+}
+
+template <typename T, class Operation,
+          TRREQUIRE(simd::is_vectorizable<T, Operation>::value)>
+void assign(T* first, T* last, Operation operation, const T& value, const T* rhs) noexcept
+{
+    simd::assign(first, last, operation, value, rhs);
+}
+
+template <typename T, class Operation,
+          TRREQUIRE(simd::is_vectorizable<T, Operation>::value)>
+void assign(T* first, T* last, Operation operation, const T* lhs, const T* rhs) noexcept
+{
+    simd::assign(first, last, operation, lhs, rhs);
+}
+
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+void axpy(T* first, T* last, const T& value, const T* src) noexcept
+{
+    while (first != last)
+    {
+        *first += value * (*src);
+
+        ++first;
+        ++src;
+    }
+}
+
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+void axpy(T* first, T* last, const T& value, const T* src) noexcept
+{
+    simd::axpy(first, last, value, src);
+}
+
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+T dot(const T* first, const T* last, const T* src) noexcept
+{
+    T result = 0;
+    while (first != last)
+    {
+        result += (*first) * (*src);
+
+        ++first;
+        ++src;
+    }
+
+    return result;
+}
+
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+T dot(const T* first, const T* last, const T* src) noexcept
+{
+    return simd::dot(first, last, src);
+}
+
+// dst[i] += value * src[i], returns sum of rhs[i] * src[i]
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+T axpy_dot(T* first, T* last, const T& value, const T* src, const T* rhs) noexcept
+{
+    T result = 0;
+    while (first != last)
+    {
+        *first += value * (*src);
+        result += (*rhs) * (*src);
+
+        ++first;
+        ++src;
+        ++rhs;
+    }
+
+    return result;
+}
+
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+T axpy_dot(T* first, T* last, const T& value, const T* src, const T* rhs) noexcept
+{
+    return simd::axpy_dot(first, last, value, src, rhs);
+}
+
+// dst[i] = value * src[i], returns sum of rhs[i] * src[i]
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+T mul_dot(T* first, T* last, const T& value, const T* src, const T* rhs) noexcept
+{
+    T result = 0;
+    while (first != last)
+    {
+        *first = value * (*src);
+        result += (*rhs) * (*src);
+
+        ++first;
+        ++src;
+        ++rhs;
+    }
+
+    return result;
+}
+
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+T mul_dot(T* first, T* last, const T& value, const T* src, const T* rhs) noexcept
+{
+    return simd::mul_dot(first, last, value, src, rhs);
+}
+
+// number of columns of vector-matrix product that are finished at once, fits in L1 cache
+constexpr std::size_t gevm_block = 256;
+
+// matrices larger than this number of elements are streamed by rows instead of column blocks,
+// since strided walk over matrix that does not fit in cache is limited by memory
+constexpr std::size_t gevm_cache_size = 1 << 18;
+
+// result[0, n) = bias[0, n) + x[0, k) . matrix[k x n], where rs is row stride of matrix
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+void gevm(
+    std::size_t k, const T* x, const T* matrix, std::size_t rs,
+    const T* bias, T* result, std::size_t n) noexcept
+{
+    for (std::size_t j = 0; j < n; ++j)
+        result[j] = bias[j];
+
+    for (std::size_t i = 0; i < k; ++i)
+        axpy(result, result + n, x[i], matrix + i * rs);
+}
+
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+void gevm(
+    std::size_t k, const T* x, const T* matrix, std::size_t rs,
+    const T* bias, T* result, std::size_t n) noexcept
+{
+    simd::gevm(k, x, matrix, rs, bias, result, n);
+}
+
+// result[i] = expression[i], for i in [first, last)
+template <typename T, class Expression, TRREQUIRE(not simd::is_packable<T>::value)>
+void evaluate(T* result, std::size_t first, std::size_t last, const Expression& expression) noexcept
+{
+    simd::Kernel<simd::IsaType::scalar>::evaluate(result, first, last, expression);
+}
+
+template <typename T, class Expression, TRREQUIRE(simd::is_packable<T>::value)>
+void evaluate(T* result, std::size_t first, std::size_t last, const Expression& expression) noexcept
+{
+    simd::evaluate(result, first, last, expression);
+}
+
+// lets[i] in order, for i in [first, last), all of them have the same size
+template <typename T, class... Lets, TRREQUIRE(not simd::is_packable<T>::value)>
+void fuse(std::size_t first, std::size_t last, const Lets&... lets) noexcept
+{
+    simd::Kernel<simd::IsaType::scalar>::template fuse<T>(first, last, lets...);
+}
+
+template <typename T, class... Lets, TRREQUIRE(simd::is_packable<T>::value)>
+void fuse(std::size_t first, std::size_t last, const Lets&... lets) noexcept
+{
+    simd::fuse<T>(first, last, lets...);
+}
+
 template <typename FwdIt, class Function>
 void apply(FwdIt first, FwdIt last, Function function)
 {
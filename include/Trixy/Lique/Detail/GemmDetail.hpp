@@ -0,0 +1,220 @@
+#ifndef TRIXY_LIQUE_GEMM_DETAIL_HPP
+#define TRIXY_LIQUE_GEMM_DETAIL_HPP
+
+#include <cstddef> // size_t
+
+#include <Trixy/Lique/Detail/SimdDetail.hpp>
+
+#include <Trixy/Range/Unified.hpp>
+#include <Trixy/Memory/Base.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+namespace detail
+{
+
+// Blocking of the packed gemm:
+// MR x NR - register tile of the micro kernel, NR is two registers wide
+// KC      - depth of packed panels, MR x KC and KC x NR panels should stay in L1
+// MC      - height of packed block of lhs, MC x KC should stay in L2
+// NC      - width of packed block of rhs, KC x NC should stay in L3
+template <typename T, simd::IsaType isa>
+struct GemmBlock
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 2 * simd::Pack<T, isa>::size;
+
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 120;
+    static constexpr std::size_t NC = 2048;
+};
+
+template <simd::IsaType isa>
+struct GemmBlock<double, isa>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 2 * simd::Pack<double, isa>::size;
+
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 60;
+    static constexpr std::size_t NC = 1024;
+};
+
+// scalar tile is left to compiler, it is vectorized by baseline instruction set
+template <>
+struct GemmBlock<float, simd::IsaType::scalar>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 8;
+
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 120;
+    static constexpr std::size_t NC = 2048;
+};
+
+template <>
+struct GemmBlock<double, simd::IsaType::scalar>
+{
+    static constexpr std::size_t MR = 6;
+    static constexpr std::size_t NR = 4;
+
+    static constexpr std::size_t KC = 256;
+    static constexpr std::size_t MC = 60;
+    static constexpr std::size_t NC = 1024;
+};
+
+// below this number of multiply-add operations packing does not pay off
+constexpr std::size_t gemm_small_size = 32 * 32 * 32;
+
+template <typename T>
+inline std::size_t gemm_min(T lhs, T rhs) noexcept
+{
+    return lhs < rhs ? lhs : rhs;
+}
+
+// Copy block of lhs to MR row panels: buff[panel][k][MR], tail rows padded by zero
+template <std::size_t MR, typename T>
+void gemm_pack_lhs(
+    std::size_t mc, std::size_t kc,
+    const T* lhs, std::size_t rs, std::size_t cs,
+    T* buff) noexcept
+{
+    for (std::size_t i = 0; i < mc; i += MR)
+    {
+        const std::size_t mr = gemm_min(MR, mc - i);
+
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+            const T* src = lhs + i * rs + p * cs;
+
+            std::size_t r = 0;
+            for (; r < mr; ++r) *buff++ = src[r * rs];
+            for (; r < MR; ++r) *buff++ = T(0);
+        }
+    }
+}
+
+// Copy block of rhs to NR column panels: buff[panel][k][NR], tail columns padded by zero
+template <std::size_t NR, typename T>
+void gemm_pack_rhs(
+    std::size_t kc, std::size_t nc,
+    const T* rhs, std::size_t rs, std::size_t cs,
+    T* buff) noexcept
+{
+    for (std::size_t j = 0; j < nc; j += NR)
+    {
+        const std::size_t nr = gemm_min(NR, nc - j);
+
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+            const T* src = rhs + p * rs + j * cs;
+
+            std::size_t c = 0;
+            for (; c < nr; ++c) *buff++ = src[c * cs];
+            for (; c < NR; ++c) *buff++ = T(0);
+        }
+    }
+}
+
+template <typename T>
+void gemm_small(
+    std::size_t m, std::size_t n, std::size_t k,
+    const T* lhs, std::size_t lhs_rs, std::size_t lhs_cs,
+    const T* rhs, std::size_t rhs_rs, std::size_t rhs_cs,
+    T* result, std::size_t result_rs, std::size_t result_cs, bool accumulate = true) noexcept
+{
+    for (std::size_t i = 0; i < m; ++i)
+    {
+        if (not accumulate)
+            for (std::size_t j = 0; j < n; ++j) result[i * result_rs + j * result_cs] = T(0);
+
+        for (std::size_t r = 0; r < k; ++r)
+        {
+            const T value = lhs[i * lhs_rs + r * lhs_cs];
+
+            const T* src = rhs + r * rhs_rs;
+            T* dst = result + i * result_rs;
+
+            for (std::size_t j = 0; j < n; ++j)
+                dst[j * result_cs] += value * src[j * rhs_cs];
+        }
+    }
+}
+
+// Packed blocks live as long as thread, so they are taken from heap even if short-lived allocator is bound
+template <typename T>
+utility::Range<T, RangeType::Unified> gemm_buffer(std::size_t size)
+{
+    memory::AllocatorScope scope(memory::default_allocator());
+    return utility::Range<T, RangeType::Unified>(size);
+}
+
+// Packed matrix multiplication with accumulation: result += lhs . rhs,
+// where lhs is m x k, rhs is k x n and result is m x n matrices,
+// each of them is described by data pointer, row stride (rs) and column stride (cs),
+// register tiles are computed by Kernel::gemm_micro_kernel;
+// if not accumulate, the first block of k overwrites result, so it needs no zeroing
+template <class Kernel, typename T>
+void gemm_packed(
+    std::size_t m, std::size_t n, std::size_t k,
+    const T* lhs, std::size_t lhs_rs, std::size_t lhs_cs,
+    const T* rhs, std::size_t rhs_rs, std::size_t rhs_cs,
+    T* result, std::size_t result_rs, std::size_t result_cs, bool accumulate = true) noexcept
+{
+    using Block = GemmBlock<T, Kernel::isa>;
+    using Buffer = utility::Range<T, RangeType::Unified>;
+
+    // packed blocks are allocated once per thread
+    thread_local Buffer packed_lhs = gemm_buffer<T>(Block::MC * Block::KC);
+    thread_local Buffer packed_rhs = gemm_buffer<T>(Block::KC * Block::NC);
+
+    for (std::size_t jc = 0; jc < n; jc += Block::NC)
+    {
+        const std::size_t nc = gemm_min(Block::NC, n - jc);
+
+        for (std::size_t pc = 0; pc < k; pc += Block::KC)
+        {
+            const std::size_t kc = gemm_min(Block::KC, k - pc);
+
+            gemm_pack_rhs<Block::NR>(kc, nc, rhs + pc * rhs_rs + jc * rhs_cs, rhs_rs, rhs_cs, packed_rhs.data());
+
+            for (std::size_t ic = 0; ic < m; ic += Block::MC)
+            {
+                const std::size_t mc = gemm_min(Block::MC, m - ic);
+
+                gemm_pack_lhs<Block::MR>(mc, kc, lhs + ic * lhs_rs + pc * lhs_cs, lhs_rs, lhs_cs, packed_lhs.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += Block::NR)
+                {
+                    const std::size_t nr = gemm_min(Block::NR, nc - jr);
+
+                    for (std::size_t ir = 0; ir < mc; ir += Block::MR)
+                    {
+                        const std::size_t mr = gemm_min(Block::MR, mc - ir);
+
+                        Kernel::gemm_micro_kernel(
+                            kc,
+                            packed_lhs.data() + ir * kc,
+                            packed_rhs.data() + jr * kc,
+                            result + (ic + ir) * result_rs + (jc + jr) * result_cs,
+                            result_rs, result_cs,
+                            mr, nr, accumulate or pc > 0
+                        );
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_GEMM_DETAIL_HPP
@@ -0,0 +1,242 @@
+#ifndef TRIXY_LIQUE_KERNEL_DETAIL_HPP
+#define TRIXY_LIQUE_KERNEL_DETAIL_HPP
+
+#include <cstddef> // size_t
+#include <type_traits> // is_same, true_type, false_type
+
+#include <Trixy/Lique/Detail/SimdDetail.hpp>
+#include <Trixy/Lique/Detail/GemmDetail.hpp>
+
+#include <Trixy/Detail/TrixyMeta.hpp>
+#include <Trixy/Detail/MetaMacro.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+namespace detail
+{
+
+struct cpy;
+struct add;
+struct sub;
+struct mul;
+
+namespace simd
+{
+
+template <IsaType isa>
+struct Kernel;
+
+} // namespace simd
+
+} // namespace detail
+
+namespace lazy
+{
+
+struct plus;
+struct minus;
+struct multiplies;
+struct divides;
+struct square_root;
+struct reciprocal_square_root;
+
+template <typename T> struct Ref;
+template <typename T> struct Scalar;
+
+template <class Operation, class Lhs, class Rhs> struct Binary;
+template <class Operation, class Expression> struct Unary;
+template <typename T, class Expression> struct Let;
+
+} // namespace lazy
+
+} // namespace lique
+
+} // namespace trixy
+
+#define TRIXY_SIMD_ISA ::trixy::lique::detail::simd::IsaType::scalar
+#include <Trixy/Lique/Detail/SimdKernel.hpp>
+#undef TRIXY_SIMD_ISA
+
+#ifdef TRIXY_SIMD_X86
+    #define TRIXY_SIMD_ISA ::trixy::lique::detail::simd::IsaType::sse2
+    #include <Trixy/Lique/Detail/SimdKernel.hpp>
+    #undef TRIXY_SIMD_ISA
+
+    TRIXY_SIMD_TARGET_BEGIN_AVX2
+    #define TRIXY_SIMD_ISA ::trixy::lique::detail::simd::IsaType::avx2
+    #include <Trixy/Lique/Detail/SimdKernel.hpp>
+    #undef TRIXY_SIMD_ISA
+    TRIXY_SIMD_TARGET_END
+
+    TRIXY_SIMD_TARGET_BEGIN_AVX512
+    #define TRIXY_SIMD_ISA ::trixy::lique::detail::simd::IsaType::avx512
+    #include <Trixy/Lique/Detail/SimdKernel.hpp>
+    #undef TRIXY_SIMD_ISA
+    TRIXY_SIMD_TARGET_END
+#endif // TRIXY_SIMD_X86
+
+namespace trixy
+{
+
+namespace lique
+{
+
+namespace detail
+{
+
+namespace simd
+{
+
+template <typename T>
+struct is_packable
+    : trixy::meta::or_<std::is_same<T, float>, std::is_same<T, double>> {};
+
+template <class Operation> struct is_pack_operation : std::false_type {};
+
+template <> struct is_pack_operation<cpy> : std::true_type {};
+template <> struct is_pack_operation<add> : std::true_type {};
+template <> struct is_pack_operation<sub> : std::true_type {};
+template <> struct is_pack_operation<mul> : std::true_type {};
+
+template <typename T, class Operation>
+struct is_vectorizable
+    : trixy::meta::and_<is_packable<T>, is_pack_operation<Operation>> {};
+
+// below this number of elements the call of selected kernel does not pay off
+constexpr std::size_t dispatch_min_size = 16;
+
+// Call function with kernel of the selected instruction set
+template <class Function>
+auto dispatch(std::size_t size, Function function) -> decltype(function(Kernel<IsaType::scalar>()))
+{
+    if (size < dispatch_min_size) return function(Kernel<IsaType::scalar>());
+
+    switch (isa())
+    {
+#ifdef TRIXY_SIMD_X86
+    case IsaType::avx512: return function(Kernel<IsaType::avx512>());
+    case IsaType::avx2: return function(Kernel<IsaType::avx2>());
+    case IsaType::sse2: return function(Kernel<IsaType::sse2>());
+#endif
+    default: return function(Kernel<IsaType::scalar>());
+    }
+}
+
+template <typename T, class Operation>
+void assign(T* first, T* last, Operation operation, const T& value) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::assign(first, last, operation, value); });
+}
+
+template <typename T, class Operation>
+void assign(T* first, T* last, Operation operation, const T* src) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::assign(first, last, operation, src); });
+}
+
+template <typename T, class Operation>
+void assign(T* first, T* last, Operation operation, const T& value, const T* rhs) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::assign(first, last, operation, value, rhs); });
+}
+
+template <typename T, class Operation>
+void assign(T* first, T* last, Operation operation, const T* lhs, const T* rhs) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::assign(first, last, operation, lhs, rhs); });
+}
+
+template <typename T>
+void axpy(T* first, T* last, T value, const T* src) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::axpy(first, last, value, src); });
+}
+
+template <typename T>
+T axpy_dot(T* first, T* last, T value, const T* src, const T* rhs) noexcept
+{
+    return dispatch(last - first, [&](auto kernel) { return decltype(kernel)::axpy_dot(first, last, value, src, rhs); });
+}
+
+template <typename T>
+T mul_dot(T* first, T* last, T value, const T* src, const T* rhs) noexcept
+{
+    return dispatch(last - first, [&](auto kernel) { return decltype(kernel)::mul_dot(first, last, value, src, rhs); });
+}
+
+template <typename T>
+T dot(const T* first, const T* last, const T* src) noexcept
+{
+    return dispatch(last - first, [&](auto kernel) { return decltype(kernel)::dot(first, last, src); });
+}
+
+template <typename T>
+void gevm(
+    std::size_t k, const T* x, const T* matrix, std::size_t rs,
+    const T* bias, T* result, std::size_t n) noexcept
+{
+    dispatch(n, [&](auto kernel) { decltype(kernel)::gevm(k, x, matrix, rs, bias, result, n); });
+}
+
+// result[i] = expression[i], for i in [first, last)
+template <typename T, class Expression>
+void evaluate(T* result, std::size_t first, std::size_t last, const Expression& expression) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::evaluate(result, first, last, expression); });
+}
+
+// lets[i] in order, for i in [first, last)
+template <typename T, class... Lets>
+void fuse(std::size_t first, std::size_t last, const Lets&... lets) noexcept
+{
+    dispatch(last - first, [&](auto kernel) { decltype(kernel)::template fuse<T>(first, last, lets...); });
+}
+
+} // namespace simd
+
+// General matrix multiplication with accumulation: result += lhs . rhs, or result = lhs . rhs if not accumulate,
+// where lhs is m x k, rhs is k x n and result is m x n matrices,
+// each of them is described by data pointer, row stride (rs) and column stride (cs)
+template <typename T, TRREQUIRE(simd::is_packable<T>::value)>
+void gemm(
+    std::size_t m, std::size_t n, std::size_t k,
+    const T* lhs, std::size_t lhs_rs, std::size_t lhs_cs,
+    const T* rhs, std::size_t rhs_rs, std::size_t rhs_cs,
+    T* result, std::size_t result_rs, std::size_t result_cs, bool accumulate = true) noexcept
+{
+    if (m == 0 || n == 0 || (k == 0 && accumulate)) return;
+
+    if (m * n * k <= gemm_small_size)
+    {
+        gemm_small(m, n, k, lhs, lhs_rs, lhs_cs, rhs, rhs_rs, rhs_cs, result, result_rs, result_cs, accumulate);
+        return;
+    }
+
+    simd::dispatch(m * n * k, [&](auto kernel)
+    {
+        gemm_packed<decltype(kernel)>(
+            m, n, k, lhs, lhs_rs, lhs_cs, rhs, rhs_rs, rhs_cs, result, result_rs, result_cs, accumulate);
+    });
+}
+
+template <typename T, TRREQUIRE(not simd::is_packable<T>::value)>
+void gemm(
+    std::size_t m, std::size_t n, std::size_t k,
+    const T* lhs, std::size_t lhs_rs, std::size_t lhs_cs,
+    const T* rhs, std::size_t rhs_rs, std::size_t rhs_cs,
+    T* result, std::size_t result_rs, std::size_t result_cs, bool accumulate = true) noexcept
+{
+    gemm_small(m, n, k, lhs, lhs_rs, lhs_cs, rhs, rhs_rs, rhs_cs, result, result_rs, result_cs, accumulate);
+}
+
+} // namespace detail
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_KERNEL_DETAIL_HPP
@@ -26,6 +26,18 @@ template <typename> struct is_tensor_type : std::false_type {};
 template <typename Precision, typename TensrorType, typename TensorMode>
 struct is_tensor_type<Tensor<Precision, TensrorType, TensorMode>> : std::true_type {};
 
+// strided view is not dense, so it's not serializable as tensor
+template <typename Precision>
+struct is_tensor_type<Tensor<Precision, lique::TensorType::strided, lique::TensorMode::view>> : std::false_type {};
+
+// batch is serialized as matrix followed by shape of sample
+template <typename Precision>
+struct is_tensor_type<Tensor<Precision, lique::TensorType::batch, lique::TensorMode::own>> : std::false_type {};
+
+template <typename> struct is_own_tensor : std::false_type {};
+template <typename Precision, typename TensrorType>
+struct is_own_tensor<Tensor<Precision, TensrorType, lique::TensorMode::own>> : std::true_type {};
+
 template <class Tensor>
 struct is_vector : std::is_base_of<lique::TensorType::vector, Tensor> {};
 
@@ -35,6 +47,16 @@ struct is_matrix : std::is_base_of<lique::TensorType::matrix, Tensor> {};
 template <class Tensor>
 struct is_tensor : std::is_base_of<lique::TensorType::tensor, Tensor> {};
 
+template <class Tensor>
+struct is_strided : std::is_base_of<lique::TensorType::strided, Tensor> {};
+
+template <class Tensor>
+struct is_batch : std::is_base_of<lique::TensorType::batch, Tensor> {};
+
+// dense matrix or strided view, that is accepted by gemm
+template <class Tensor>
+struct is_matrix_operand : trixy::meta::or_<is_matrix<Tensor>, is_strided<Tensor>> {};
+
 template <class Tensor>
 struct is_iterate : trixy::meta::or_
 <
@@ -53,6 +75,15 @@ using as_matrix = trixy::meta::require<is_matrix<T>::value>;
 template <typename T>
 using as_tensor = trixy::meta::require<is_tensor<T>::value>;
 
+template <typename T>
+using as_strided = trixy::meta::require<is_strided<T>::value>;
+
+template <typename T>
+using as_batch = trixy::meta::require<is_batch<T>::value>;
+
+template <typename T>
+using as_matrix_operand = trixy::meta::require<is_matrix_operand<T>::value>;
+
 template <typename T>
 using as_iterate = trixy::meta::require<is_iterate<T>::value>;
 
@@ -0,0 +1,383 @@
+#ifndef TRIXY_LIQUE_SIMD_DETAIL_HPP
+#define TRIXY_LIQUE_SIMD_DETAIL_HPP
+
+#include <cstddef> // size_t
+#include <cstdlib> // getenv
+#include <cstring> // strcmp
+#include <cmath> // sqrt
+
+// Kernels for every supported instruction set are compiled into the same binary,
+// the best one for the running cpu is selected once, see simd::isa()
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+    #define TRIXY_SIMD_X86
+#endif
+
+#ifdef TRIXY_SIMD_X86
+    #include <immintrin.h>
+
+    #ifdef _MSC_VER
+        #include <intrin.h> // __cpuid, __cpuidex
+    #endif
+#endif
+
+// Begin/end region of code that is compiled for specific instruction set
+#if defined(__clang__)
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX2                                                            \
+        _Pragma("clang attribute push (__attribute__((target(\"avx2,fma\"))), apply_to = function)")
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX512                                                          \
+        _Pragma("clang attribute push (__attribute__((target(\"avx512f,avx2,fma\"))), apply_to = function)")
+    #define TRIXY_SIMD_TARGET_END                                                                   \
+        _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX2                                                            \
+        _Pragma("GCC push_options") _Pragma("GCC target(\"avx2,fma\")")
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX512                                                          \
+        _Pragma("GCC push_options") _Pragma("GCC target(\"avx512f,avx2,fma\")")
+    #define TRIXY_SIMD_TARGET_END                                                                   \
+        _Pragma("GCC pop_options")
+#else
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX2
+    #define TRIXY_SIMD_TARGET_BEGIN_AVX512
+    #define TRIXY_SIMD_TARGET_END
+#endif
+
+// Full unrolling of small constant loops, keeps register tiles out of memory
+#if defined(__clang__)
+    #define TRIXY_SIMD_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+    #define TRIXY_SIMD_UNROLL _Pragma("GCC unroll 16")
+#else
+    #define TRIXY_SIMD_UNROLL
+#endif
+
+namespace trixy
+{
+
+namespace lique
+{
+
+namespace detail
+{
+
+namespace simd
+{
+
+enum class IsaType { scalar, sse2, avx2, avx512 };
+
+// Register wrapper for given precision and instruction set
+template <typename T, IsaType isa>
+struct Pack;
+
+template <typename T>
+struct Pack<T, IsaType::scalar>
+{
+    using type = T;
+    static constexpr std::size_t size = 1;
+
+    static type load(const T* src) noexcept { return *src; }
+    static type load_aligned(const T* src) noexcept { return *src; }
+    static void store(T* dst, type x) noexcept { *dst = x; }
+    static type set(T value) noexcept { return value; }
+
+    static type add(type lhs, type rhs) noexcept { return lhs + rhs; }
+    static type sub(type lhs, type rhs) noexcept { return lhs - rhs; }
+    static type mul(type lhs, type rhs) noexcept { return lhs * rhs; }
+    static type div(type lhs, type rhs) noexcept { return lhs / rhs; }
+
+    static type sqrt(type x) noexcept { return std::sqrt(x); }
+    static type rsqrt(type x) noexcept { return T(1) / std::sqrt(x); }
+
+    // a * b + c
+    static type fmadd(type a, type b, type c) noexcept { return a * b + c; }
+    static T sum(type x) noexcept { return x; }
+};
+
+#ifdef TRIXY_SIMD_X86
+template <>
+struct Pack<float, IsaType::sse2>
+{
+    using type = __m128;
+    static constexpr std::size_t size = 4;
+
+    static type load(const float* src) noexcept { return _mm_loadu_ps(src); }
+    static type load_aligned(const float* src) noexcept { return _mm_load_ps(src); }
+    static void store(float* dst, type x) noexcept { _mm_storeu_ps(dst, x); }
+    static type set(float value) noexcept { return _mm_set1_ps(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm_add_ps(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm_sub_ps(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm_mul_ps(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm_div_ps(lhs, rhs); }
+
+    static type sqrt(type x) noexcept { return _mm_sqrt_ps(x); }
+
+    // estimate of 12 bits is refined by Newton step: y * (1.5 - 0.5 * x * y * y)
+    static type rsqrt(type x) noexcept
+    {
+        const type y = _mm_rsqrt_ps(x);
+        const type h = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(y, y));
+        return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), h));
+    }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    static float sum(type x) noexcept
+    {
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 1));
+        return _mm_cvtss_f32(x);
+    }
+};
+
+template <>
+struct Pack<double, IsaType::sse2>
+{
+    using type = __m128d;
+    static constexpr std::size_t size = 2;
+
+    static type load(const double* src) noexcept { return _mm_loadu_pd(src); }
+    static type load_aligned(const double* src) noexcept { return _mm_load_pd(src); }
+    static void store(double* dst, type x) noexcept { _mm_storeu_pd(dst, x); }
+    static type set(double value) noexcept { return _mm_set1_pd(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm_add_pd(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm_sub_pd(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm_mul_pd(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm_div_pd(lhs, rhs); }
+
+    static type sqrt(type x) noexcept { return _mm_sqrt_pd(x); }
+    static type rsqrt(type x) noexcept { return _mm_div_pd(_mm_set1_pd(1.), _mm_sqrt_pd(x)); }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+
+    static double sum(type x) noexcept
+    {
+        return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+    }
+};
+
+TRIXY_SIMD_TARGET_BEGIN_AVX2
+
+template <>
+struct Pack<float, IsaType::avx2>
+{
+    using type = __m256;
+    static constexpr std::size_t size = 8;
+
+    static type load(const float* src) noexcept { return _mm256_loadu_ps(src); }
+    static type load_aligned(const float* src) noexcept { return _mm256_load_ps(src); }
+    static void store(float* dst, type x) noexcept { _mm256_storeu_ps(dst, x); }
+    static type set(float value) noexcept { return _mm256_set1_ps(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm256_add_ps(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm256_sub_ps(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm256_mul_ps(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm256_div_ps(lhs, rhs); }
+
+    static type sqrt(type x) noexcept { return _mm256_sqrt_ps(x); }
+
+    static type rsqrt(type x) noexcept
+    {
+        const type y = _mm256_rsqrt_ps(x);
+        const type h = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), _mm256_mul_ps(y, y));
+        return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), h));
+    }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+
+    static float sum(type x) noexcept
+    {
+        __m128 y = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+        y = _mm_add_ps(y, _mm_movehl_ps(y, y));
+        y = _mm_add_ss(y, _mm_shuffle_ps(y, y, 1));
+        return _mm_cvtss_f32(y);
+    }
+};
+
+template <>
+struct Pack<double, IsaType::avx2>
+{
+    using type = __m256d;
+    static constexpr std::size_t size = 4;
+
+    static type load(const double* src) noexcept { return _mm256_loadu_pd(src); }
+    static type load_aligned(const double* src) noexcept { return _mm256_load_pd(src); }
+    static void store(double* dst, type x) noexcept { _mm256_storeu_pd(dst, x); }
+    static type set(double value) noexcept { return _mm256_set1_pd(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm256_add_pd(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm256_sub_pd(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm256_mul_pd(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm256_div_pd(lhs, rhs); }
+
+    static type sqrt(type x) noexcept { return _mm256_sqrt_pd(x); }
+    static type rsqrt(type x) noexcept { return _mm256_div_pd(_mm256_set1_pd(1.), _mm256_sqrt_pd(x)); }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm256_fmadd_pd(a, b, c); }
+
+    static double sum(type x) noexcept
+    {
+        __m128d y = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(y, _mm_unpackhi_pd(y, y)));
+    }
+};
+
+TRIXY_SIMD_TARGET_END
+
+TRIXY_SIMD_TARGET_BEGIN_AVX512
+
+template <>
+struct Pack<float, IsaType::avx512>
+{
+    using type = __m512;
+    static constexpr std::size_t size = 16;
+
+    static type load(const float* src) noexcept { return _mm512_loadu_ps(src); }
+    static type load_aligned(const float* src) noexcept { return _mm512_load_ps(src); }
+    static void store(float* dst, type x) noexcept { _mm512_storeu_ps(dst, x); }
+    static type set(float value) noexcept { return _mm512_set1_ps(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm512_add_ps(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm512_sub_ps(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm512_mul_ps(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm512_div_ps(lhs, rhs); }
+
+    // zero mask instead of plain intrinsic, which reads undefined register in gcc headers, see sum
+    static type sqrt(type x) noexcept { return _mm512_maskz_sqrt_ps(0xFFFF, x); }
+
+    // estimate of 14 bits, refined as for sse2, zero mask as for sqrt
+    static type rsqrt(type x) noexcept
+    {
+        const type y = _mm512_maskz_rsqrt14_ps(0xFFFF, x);
+        const type h = _mm512_mul_ps(_mm512_mul_ps(_mm512_set1_ps(0.5f), x), _mm512_mul_ps(y, y));
+        return _mm512_mul_ps(y, _mm512_sub_ps(_mm512_set1_ps(1.5f), h));
+    }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm512_fmadd_ps(a, b, c); }
+
+    // halves are added and reduced as by avx2: extract with zero mask needs only avx512f
+    // and, unlike casts and _mm512_reduce_add_ps, does not read undefined register in gcc headers
+    static float sum(type x) noexcept
+    {
+        const __m512d y = _mm512_castps_pd(x);
+
+        const __m256 low = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, y, 0));
+        const __m256 high = _mm256_castpd_ps(_mm512_maskz_extractf64x4_pd(0xFF, y, 1));
+
+        return Pack<float, IsaType::avx2>::sum(_mm256_add_ps(low, high));
+    }
+};
+
+template <>
+struct Pack<double, IsaType::avx512>
+{
+    using type = __m512d;
+    static constexpr std::size_t size = 8;
+
+    static type load(const double* src) noexcept { return _mm512_loadu_pd(src); }
+    static type load_aligned(const double* src) noexcept { return _mm512_load_pd(src); }
+    static void store(double* dst, type x) noexcept { _mm512_storeu_pd(dst, x); }
+    static type set(double value) noexcept { return _mm512_set1_pd(value); }
+
+    static type add(type lhs, type rhs) noexcept { return _mm512_add_pd(lhs, rhs); }
+    static type sub(type lhs, type rhs) noexcept { return _mm512_sub_pd(lhs, rhs); }
+    static type mul(type lhs, type rhs) noexcept { return _mm512_mul_pd(lhs, rhs); }
+    static type div(type lhs, type rhs) noexcept { return _mm512_div_pd(lhs, rhs); }
+
+    static type sqrt(type x) noexcept { return _mm512_maskz_sqrt_pd(0xFF, x); }
+    static type rsqrt(type x) noexcept { return _mm512_div_pd(_mm512_set1_pd(1.), sqrt(x)); }
+
+    static type fmadd(type a, type b, type c) noexcept { return _mm512_fmadd_pd(a, b, c); }
+
+    // see Pack<float, IsaType::avx512>::sum
+    static double sum(type x) noexcept
+    {
+        const __m256d low = _mm512_maskz_extractf64x4_pd(0xFF, x, 0);
+        const __m256d high = _mm512_maskz_extractf64x4_pd(0xFF, x, 1);
+
+        return Pack<double, IsaType::avx2>::sum(_mm256_add_pd(low, high));
+    }
+};
+
+TRIXY_SIMD_TARGET_END
+
+inline bool is_supported(IsaType isa) noexcept
+{
+#if defined(__GNUC__)
+    switch (isa)
+    {
+    case IsaType::avx512: return __builtin_cpu_supports("avx512f");
+    case IsaType::avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    default: return true;
+    }
+#else
+    int info[4];
+
+    __cpuid(info, 0);
+    if (info[0] < 7) return isa == IsaType::scalar || isa == IsaType::sse2;
+
+    __cpuid(info, 1);
+    const bool fma = info[2] & (1 << 12);
+    const bool osxsave = info[2] & (1 << 27);
+
+    // xmm, ymm and zmm states should be enabled by os
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+    __cpuidex(info, 7, 0);
+    const bool avx2 = info[1] & (1 << 5);
+    const bool avx512f = info[1] & (1 << 16);
+
+    switch (isa)
+    {
+    case IsaType::avx512: return avx512f && (xcr0 & 0xe6) == 0xe6;
+    case IsaType::avx2: return avx2 && fma && (xcr0 & 0x6) == 0x6;
+    default: return true;
+    }
+#endif
+}
+#else
+inline bool is_supported(IsaType isa) noexcept { return isa == IsaType::scalar; }
+#endif // TRIXY_SIMD_X86
+
+inline IsaType select_isa() noexcept
+{
+    // environment variable TRIXY_LIQUE_ISA=scalar|sse2|avx2|avx512 forces specific kernels,
+    // unsupported or unknown value is ignored
+    const char* name = std::getenv("TRIXY_LIQUE_ISA");
+    if (name != nullptr)
+    {
+        IsaType forced = IsaType::scalar;
+        bool is_known = true;
+
+        if (std::strcmp(name, "scalar") == 0) forced = IsaType::scalar;
+        else if (std::strcmp(name, "sse2") == 0) forced = IsaType::sse2;
+        else if (std::strcmp(name, "avx2") == 0) forced = IsaType::avx2;
+        else if (std::strcmp(name, "avx512") == 0) forced = IsaType::avx512;
+        else is_known = false;
+
+        if (is_known && is_supported(forced)) return forced;
+    }
+
+    if (is_supported(IsaType::avx512)) return IsaType::avx512;
+    if (is_supported(IsaType::avx2)) return IsaType::avx2;
+    if (is_supported(IsaType::sse2)) return IsaType::sse2;
+
+    return IsaType::scalar;
+}
+
+// Instruction set of the kernels used by lique, selected on first call
+inline IsaType isa() noexcept
+{
+    static const IsaType selected = select_isa();
+    return selected;
+}
+
+} // namespace simd
+
+} // namespace detail
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_SIMD_DETAIL_HPP
@@ -0,0 +1,431 @@
+// Kernels for a single instruction set, this file has no include guard:
+// KernelDetail.hpp includes it once per instruction set with defined TRIXY_SIMD_ISA,
+// inside of the matching target region
+
+namespace trixy
+{
+
+namespace lique
+{
+
+namespace detail
+{
+
+namespace simd
+{
+
+template <>
+struct Kernel<TRIXY_SIMD_ISA>
+{
+    static constexpr IsaType isa = TRIXY_SIMD_ISA;
+
+    template <class P>
+    static typename P::type pack(const cpy&, typename P::type, typename P::type rhs) noexcept
+    { return rhs; }
+
+    template <class P>
+    static typename P::type pack(const add&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::add(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const sub&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::sub(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const mul&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::mul(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const lazy::plus&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::add(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const lazy::minus&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::sub(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const lazy::multiplies&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::mul(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const lazy::divides&, typename P::type lhs, typename P::type rhs) noexcept
+    { return P::div(lhs, rhs); }
+
+    template <class P>
+    static typename P::type pack(const lazy::square_root&, typename P::type x) noexcept
+    { return P::sqrt(x); }
+
+    template <class P>
+    static typename P::type pack(const lazy::reciprocal_square_root&, typename P::type x) noexcept
+    { return P::rsqrt(x); }
+
+    // value of expression tree at index i, evaluated with pack P
+    template <class P, typename T>
+    static typename P::type eval(const lazy::Scalar<T>& expression, std::size_t) noexcept
+    { return P::set(expression.value); }
+
+    template <class P, typename T>
+    static typename P::type eval(const lazy::Ref<T>& expression, std::size_t i) noexcept
+    { return P::load(expression.data + i); }
+
+    template <class P, class Operation, class Lhs, class Rhs>
+    static typename P::type eval(const lazy::Binary<Operation, Lhs, Rhs>& expression, std::size_t i) noexcept
+    { return pack<P>(Operation(), eval<P>(expression.lhs, i), eval<P>(expression.rhs, i)); }
+
+    template <class P, class Operation, class Expression>
+    static typename P::type eval(const lazy::Unary<Operation, Expression>& expression, std::size_t i) noexcept
+    { return pack<P>(Operation(), eval<P>(expression.expression, i)); }
+
+    // dst[i] = operation(dst[i], value)
+    template <typename T, class Operation>
+    static void assign(T* first, T* last, Operation operation, const T& value) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % P::size;
+
+        const auto x = P::set(value);
+
+        for (std::size_t i = 0; i < body; i += P::size)
+            P::store(first + i, pack<P>(operation, P::load(first + i), x));
+
+        for (std::size_t i = body; i < size; ++i)
+            operation(first[i], value);
+    }
+
+    // dst[i] = operation(dst[i], src[i])
+    template <typename T, class Operation>
+    static void assign(T* first, T* last, Operation operation, const T* src) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % P::size;
+
+        for (std::size_t i = 0; i < body; i += P::size)
+            P::store(first + i, pack<P>(operation, P::load(first + i), P::load(src + i)));
+
+        for (std::size_t i = body; i < size; ++i)
+            operation(first[i], src[i]);
+    }
+
+    // dst[i] = operation(value, rhs[i])
+    template <typename T, class Operation>
+    static void assign(T* first, T* last, Operation operation, const T& value, const T* rhs) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % P::size;
+
+        const auto x = P::set(value);
+
+        for (std::size_t i = 0; i < body; i += P::size)
+            P::store(first + i, pack<P>(operation, x, P::load(rhs + i)));
+
+        for (std::size_t i = body; i < size; ++i)
+            operation(first[i], value, rhs[i]);
+    }
+
+    // dst[i] = operation(lhs[i], rhs[i])
+    template <typename T, class Operation>
+    static void assign(T* first, T* last, Operation operation, const T* lhs, const T* rhs) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % P::size;
+
+        for (std::size_t i = 0; i < body; i += P::size)
+            P::store(first + i, pack<P>(operation, P::load(lhs + i), P::load(rhs + i)));
+
+        for (std::size_t i = body; i < size; ++i)
+            operation(first[i], lhs[i], rhs[i]);
+    }
+
+    // result[i] = expression[i], for i in [first, last)
+    template <typename T, class Expression>
+    static void evaluate(T* result, std::size_t first, std::size_t last, const Expression& expression) noexcept
+    {
+        using P = Pack<T, isa>;
+        using S = Pack<T, IsaType::scalar>;
+
+        std::size_t i = first;
+
+        for (; i + P::size <= last; i += P::size)
+            P::store(result + i, eval<P>(expression, i));
+
+        for (; i < last; ++i)
+            result[i] = eval<S>(expression, i);
+    }
+
+    // for each pack of elements all assignments are evaluated in order,
+    // so the later ones read values of the former from registers or cache
+    template <typename T, class... Lets>
+    static void fuse(std::size_t first, std::size_t last, const Lets&... lets) noexcept
+    {
+        using P = Pack<T, isa>;
+        using S = Pack<T, IsaType::scalar>;
+
+        std::size_t i = first;
+
+        for (; i + P::size <= last; i += P::size)
+            (P::store(lets.data + i, eval<P>(lets.expression, i)), ...);
+
+        for (; i < last; ++i)
+            ((lets.data[i] = eval<S>(lets.expression, i)), ...);
+    }
+
+    // dst[i] += value * src[i]
+    template <typename T>
+    static void axpy(T* first, T* last, T value, const T* src) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % P::size;
+
+        const auto x = P::set(value);
+
+        for (std::size_t i = 0; i < body; i += P::size)
+            P::store(first + i, P::fmadd(x, P::load(src + i), P::load(first + i)));
+
+        for (std::size_t i = body; i < size; ++i)
+            first[i] += value * src[i];
+    }
+
+    // dst[i] += value * src[i], returns sum of rhs[i] * src[i], src is loaded once for both
+    template <typename T>
+    static T axpy_dot(T* first, T* last, T value, const T* src, const T* rhs) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % (2 * P::size);
+
+        const auto x = P::set(value);
+
+        typename P::type acc[2] = { P::set(T(0)), P::set(T(0)) };
+
+        for (std::size_t i = 0; i < body; i += 2 * P::size)
+        {
+            TRIXY_SIMD_UNROLL
+            for (std::size_t j = 0; j < 2; ++j)
+            {
+                const std::size_t t = i + j * P::size;
+                const auto s = P::load(src + t);
+
+                P::store(first + t, P::fmadd(x, s, P::load(first + t)));
+                acc[j] = P::fmadd(P::load(rhs + t), s, acc[j]);
+            }
+        }
+
+        T result = P::sum(P::add(acc[0], acc[1]));
+
+        for (std::size_t i = body; i < size; ++i)
+        {
+            first[i] += value * src[i];
+            result += rhs[i] * src[i];
+        }
+
+        return result;
+    }
+
+    // dst[i] = value * src[i], returns sum of rhs[i] * src[i], src is loaded once for both
+    template <typename T>
+    static T mul_dot(T* first, T* last, T value, const T* src, const T* rhs) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % (2 * P::size);
+
+        const auto x = P::set(value);
+
+        typename P::type acc[2] = { P::set(T(0)), P::set(T(0)) };
+
+        for (std::size_t i = 0; i < body; i += 2 * P::size)
+        {
+            TRIXY_SIMD_UNROLL
+            for (std::size_t j = 0; j < 2; ++j)
+            {
+                const std::size_t t = i + j * P::size;
+                const auto s = P::load(src + t);
+
+                P::store(first + t, P::mul(x, s));
+                acc[j] = P::fmadd(P::load(rhs + t), s, acc[j]);
+            }
+        }
+
+        T result = P::sum(P::add(acc[0], acc[1]));
+
+        for (std::size_t i = body; i < size; ++i)
+        {
+            first[i] = value * src[i];
+            result += rhs[i] * src[i];
+        }
+
+        return result;
+    }
+
+    // sum of lhs[i] * rhs[i]
+    template <typename T>
+    static T dot(const T* first, const T* last, const T* src) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        // independent accumulators hide latency of fmadd
+        constexpr std::size_t N = 4;
+
+        const std::size_t size = last - first;
+        const std::size_t body = size - size % (N * P::size);
+
+        typename P::type acc[N];
+
+        TRIXY_SIMD_UNROLL
+        for (std::size_t j = 0; j < N; ++j) acc[j] = P::set(T(0));
+
+        for (std::size_t i = 0; i < body; i += N * P::size)
+            TRIXY_SIMD_UNROLL
+            for (std::size_t j = 0; j < N; ++j)
+                acc[j] = P::fmadd(P::load(first + i + j * P::size), P::load(src + i + j * P::size), acc[j]);
+
+        T result = P::sum(P::add(P::add(acc[0], acc[1]), P::add(acc[2], acc[3])));
+
+        for (std::size_t i = body; i < size; ++i)
+            result += first[i] * src[i];
+
+        return result;
+    }
+
+    // result[0, n) = bias[0, n) + x[0, k) . matrix[k x n], where rs is row stride of matrix
+    template <typename T>
+    static void gevm(
+        std::size_t k, const T* x, const T* matrix, std::size_t rs,
+        const T* bias, T* result, std::size_t n) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        // columns of the tile are accumulated in registers over all rows of matrix
+        constexpr std::size_t NV = 4;
+        constexpr std::size_t NR = NV * P::size;
+
+        std::size_t j = 0;
+        for (; j + NR <= n; j += NR)
+        {
+            typename P::type tile[NV];
+
+            TRIXY_SIMD_UNROLL
+            for (std::size_t v = 0; v < NV; ++v)
+                tile[v] = P::load(bias + j + v * P::size);
+
+            const T* row = matrix + j;
+            for (std::size_t i = 0; i < k; ++i, row += rs)
+            {
+                const auto a = P::set(x[i]);
+
+                TRIXY_SIMD_UNROLL
+                for (std::size_t v = 0; v < NV; ++v)
+                    tile[v] = P::fmadd(a, P::load(row + v * P::size), tile[v]);
+            }
+
+            TRIXY_SIMD_UNROLL
+            for (std::size_t v = 0; v < NV; ++v)
+                P::store(result + j + v * P::size, tile[v]);
+        }
+
+        if (j == n) return;
+
+        for (std::size_t t = j; t < n; ++t)
+        {
+            T sum = bias[t];
+
+            const T* column = matrix + t;
+            for (std::size_t i = 0; i < k; ++i, column += rs)
+                sum += x[i] * (*column);
+
+            result[t] = sum;
+        }
+    }
+
+    // result[mr x nr] += lhs_panel[MR x kc] . rhs_panel[kc x NR], or = if not accumulate
+    // rhs_panel should be aligned to pack size, packed buffers are allocated aligned
+    template <typename T>
+    static void gemm_micro_kernel(
+        std::size_t kc, const T* lhs, const T* rhs,
+        T* result, std::size_t rs, std::size_t cs,
+        std::size_t mr, std::size_t nr, bool accumulate = true) noexcept
+    {
+        using P = Pack<T, isa>;
+
+        constexpr std::size_t MR = GemmBlock<T, isa>::MR;
+        constexpr std::size_t NR = GemmBlock<T, isa>::NR;
+        constexpr std::size_t NV = NR / P::size;
+
+        typename P::type tile[MR][NV];
+
+        TRIXY_SIMD_UNROLL
+        for (std::size_t i = 0; i < MR; ++i)
+            TRIXY_SIMD_UNROLL
+            for (std::size_t v = 0; v < NV; ++v)
+                tile[i][v] = P::set(T(0));
+
+        for (std::size_t p = 0; p < kc; ++p)
+        {
+            typename P::type b[NV];
+
+            TRIXY_SIMD_UNROLL
+            for (std::size_t v = 0; v < NV; ++v)
+                b[v] = P::load_aligned(rhs + v * P::size);
+
+            TRIXY_SIMD_UNROLL
+            for (std::size_t i = 0; i < MR; ++i)
+            {
+                const auto a = P::set(lhs[i]);
+
+                TRIXY_SIMD_UNROLL
+                for (std::size_t v = 0; v < NV; ++v)
+                    tile[i][v] = P::fmadd(a, b[v], tile[i][v]);
+            }
+
+            lhs += MR;
+            rhs += NR;
+        }
+
+        if (mr == MR && nr == NR && cs == 1)
+        {
+            TRIXY_SIMD_UNROLL
+            for (std::size_t i = 0; i < MR; ++i)
+            {
+                T* dst = result + i * rs;
+
+                TRIXY_SIMD_UNROLL
+                for (std::size_t v = 0; v < NV; ++v)
+                    P::store(dst + v * P::size, accumulate ? P::add(P::load(dst + v * P::size), tile[i][v])
+                                                           : tile[i][v]);
+            }
+            return;
+        }
+
+        T buff[MR][NR];
+
+        TRIXY_SIMD_UNROLL
+        for (std::size_t i = 0; i < MR; ++i)
+            TRIXY_SIMD_UNROLL
+            for (std::size_t v = 0; v < NV; ++v)
+                P::store(buff[i] + v * P::size, tile[i][v]);
+
+        for (std::size_t i = 0; i < mr; ++i)
+            for (std::size_t j = 0; j < nr; ++j)
+                result[i * rs + j * cs] = accumulate ? result[i * rs + j * cs] + buff[i][j] : buff[i][j];
+    }
+};
+
+} // namespace simd
+
+} // namespace detail
+
+} // namespace lique
+
+} // namespace trixy
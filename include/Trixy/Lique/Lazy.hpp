@@ -0,0 +1,199 @@
+#ifndef TRIXY_LIQUE_LAZY_HPP
+#define TRIXY_LIQUE_LAZY_HPP
+
+#include <cstddef> // size_t
+#include <type_traits> // remove_const, remove_pointer, is_const, true_type, false_type
+
+#include <Trixy/Lique/Detail/FunctionDetail.hpp>
+#include <Trixy/Lique/Detail/LiqueMeta.hpp>
+
+#include <Trixy/Detail/TrixyMeta.hpp>
+
+#include <Trixy/Detail/MetaMacro.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+// Element-wise expressions, that are evaluated by single vectorized pass without temporaries:
+// lazy::ref(param) -= learning_rate * lazy::ref(m) / sqrt(lazy::ref(s))
+// several assignments may be fused into one pass, see Linear::fuse:
+// linear.fuse(let(ref(m), beta * ref(m) + ref(g)), let(ref(param), ref(param) - ref(m)))
+namespace lazy
+{
+
+struct plus {};
+struct minus {};
+struct multiplies {};
+struct divides {};
+struct square_root {};
+struct reciprocal_square_root {};
+
+template <typename T>
+struct Scalar
+{
+    using value_type = T;
+
+    value_type value;
+};
+
+template <class Operation, class Lhs, class Rhs>
+struct Binary
+{
+    using value_type = typename Lhs::value_type;
+
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <class Operation, class Expression>
+struct Unary
+{
+    using value_type = typename Expression::value_type;
+
+    Expression expression;
+};
+
+// Assignment of fused pass: data[i] = expression[i]
+template <typename T, class Expression>
+struct Let
+{
+    using value_type = T;
+
+    T* data;
+    std::size_t size;
+
+    Expression expression;
+};
+
+} // namespace lazy
+
+namespace meta
+{
+
+template <typename T> struct is_expression : std::false_type {};
+
+template <typename T> struct is_expression<lazy::Ref<T>> : std::true_type {};
+template <typename T> struct is_expression<lazy::Scalar<T>> : std::true_type {};
+
+template <class Operation, class Lhs, class Rhs>
+struct is_expression<lazy::Binary<Operation, Lhs, Rhs>> : std::true_type {};
+
+template <class Operation, class Expression>
+struct is_expression<lazy::Unary<Operation, Expression>> : std::true_type {};
+
+template <typename T>
+using as_expression = trixy::meta::require<is_expression<T>::value>;
+
+template <typename T> struct is_let : std::false_type {};
+
+template <typename T, class Expression>
+struct is_let<lazy::Let<T, Expression>> : std::true_type {};
+
+template <typename... Tn>
+using as_let = trixy::meta::require<trixy::meta::and_<is_let<Tn>...>::value>;
+
+} // namespace meta
+
+namespace lazy
+{
+
+// View of tensor data inside of expression, also may be assigned by expression
+template <typename T>
+struct Ref
+{
+    using value_type = typename std::remove_const<T>::type;
+
+    T* data;
+    std::size_t size;
+
+    Ref(T* data, std::size_t size) noexcept : data(data), size(size) {}
+    Ref(const Ref&) noexcept = default;
+
+    Ref& operator= (const Ref& expression) noexcept { return assign(expression); }
+
+    template <class Expression, meta::as_expression<Expression> = 0>
+    Ref& operator= (const Expression& expression) noexcept { return assign(expression); }
+
+    template <class Expression, meta::as_expression<Expression> = 0>
+    Ref& operator+= (const Expression& expression) noexcept
+    { return assign(Binary<plus, Ref<const T>, Expression>{ { data, size }, expression }); }
+
+    template <class Expression, meta::as_expression<Expression> = 0>
+    Ref& operator-= (const Expression& expression) noexcept
+    { return assign(Binary<minus, Ref<const T>, Expression>{ { data, size }, expression }); }
+
+    template <class Expression, meta::as_expression<Expression> = 0>
+    Ref& operator*= (const Expression& expression) noexcept
+    { return assign(Binary<multiplies, Ref<const T>, Expression>{ { data, size }, expression }); }
+
+private:
+    template <class Expression>
+    Ref& assign(const Expression& expression) noexcept
+    {
+        static_assert(not std::is_const<T>::value, "Expression cannot be assigned to const data.");
+
+        detail::evaluate(data, 0, size, expression);
+        return *this;
+    }
+};
+
+template <class Iterable, lique::meta::as_iterate<Iterable> = 0>
+auto ref(Iterable& it) noexcept -> Ref<typename std::remove_pointer<decltype(it.data())>::type>
+{
+    return { it.data(), static_cast<std::size_t>(it.size()) };
+}
+
+template <class Expression, meta::as_expression<Expression> = 0>
+Unary<square_root, Expression> sqrt(const Expression& expression) noexcept
+{
+    return { expression };
+}
+
+// 1 / sqrt(x), for positive x, float may be approximated with relative error about 1e-6
+template <class Expression, meta::as_expression<Expression> = 0>
+Unary<reciprocal_square_root, Expression> rsqrt(const Expression& expression) noexcept
+{
+    return { expression };
+}
+
+// Assignment to be fused with others, it reads values assigned by the previous ones
+template <typename T, class Expression, meta::as_expression<Expression> = 0>
+Let<T, Expression> let(const Ref<T>& target, const Expression& expression) noexcept
+{
+    static_assert(not std::is_const<T>::value, "Expression cannot be assigned to const data.");
+    return { target.data, target.size, expression };
+}
+
+#define TRIXY_LAZY_BINARY_OPERATOR(op, operation)                                                       \
+    template <class Lhs, class Rhs,                                                                     \
+              meta::as_expression<Lhs> = 0, meta::as_expression<Rhs> = 0>                              \
+    Binary<operation, Lhs, Rhs> operator op (const Lhs& lhs, const Rhs& rhs) noexcept                   \
+    { return { lhs, rhs }; }                                                                            \
+                                                                                                        \
+    template <class Rhs, meta::as_expression<Rhs> = 0>                                                  \
+    Binary<operation, Scalar<typename Rhs::value_type>, Rhs> operator op (                              \
+        typename Rhs::value_type lhs, const Rhs& rhs) noexcept                                          \
+    { return { { lhs }, rhs }; }                                                                        \
+                                                                                                        \
+    template <class Lhs, meta::as_expression<Lhs> = 0>                                                  \
+    Binary<operation, Lhs, Scalar<typename Lhs::value_type>> operator op (                              \
+        const Lhs& lhs, typename Lhs::value_type rhs) noexcept                                          \
+    { return { lhs, { rhs } }; }
+
+TRIXY_LAZY_BINARY_OPERATOR(+, plus)
+TRIXY_LAZY_BINARY_OPERATOR(-, minus)
+TRIXY_LAZY_BINARY_OPERATOR(*, multiplies)
+TRIXY_LAZY_BINARY_OPERATOR(/, divides)
+
+#undef TRIXY_LAZY_BINARY_OPERATOR
+
+} // namespace lazy
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_LAZY_HPP
@@ -5,6 +5,9 @@
 
 #include <Trixy/Require/Linear.hpp>
 
+#include <Trixy/Lique/Lazy.hpp>
+#include <Trixy/Lique/Strided.hpp>
+
 #include <Trixy/Lique/Detail/FunctionDetail.hpp>
 #include <Trixy/Lique/Detail/LiqueMeta.hpp>
 
@@ -51,15 +54,49 @@ public:
         const Vector2& row_vector,
         const Matrix& matrix) const noexcept
     {
-        precision_type temp;
-
         detail::assign(first(result), last(result), detail::cpy(), precision_type(0.));
 
-        for (size_type i = 0; i < row_vector.size(); ++i)
+        auto row = first(matrix);
+        const size_type width = matrix.shape().width;
+
+        for (size_type i = 0; i < row_vector.size(); ++i, row += width)
+            detail::axpy(first(result), last(result), row_vector(i), row);
+    }
+
+    // result = row_vector . matrix + bias, evaluated by blocks of columns,
+    // function(first, last) is called once block [first, last) of result is finished
+    template <class Vector1, class Vector2, class Matrix, class Vector3, class Function,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0,
+              as_flat_iterate<Vector3> = 0>
+    void dot(
+        Vector1& result,
+        const Vector2& row_vector,
+        const Matrix& matrix,
+        const Vector3& bias,
+        Function function) const TRNOEXCEPT_IF(noexcept(function))
+    {
+        const size_type height = row_vector.size();
+        const size_type width = matrix.shape().width;
+
+        if (height * width > detail::gevm_cache_size)
+        {
+            detail::copy(first(result), last(result), first(bias));
+
+            auto row = first(matrix);
+            for (size_type i = 0; i < height; ++i, row += width)
+                detail::axpy(first(result), last(result), row_vector(i), row);
+        }
+
+        for (size_type j = 0; j < width; j += detail::gevm_block)
         {
-            temp = row_vector(i);
-            for (size_type j = 0; j < result.size(); ++j)
-                result(j) += temp * matrix(i, j);
+            const size_type n = detail::gevm_block < width - j ? detail::gevm_block : width - j;
+
+            if (height * width <= detail::gevm_cache_size)
+                detail::gevm(height, first(row_vector), first(matrix) + j, width, first(bias) + j, first(result) + j, n);
+
+            function(j, j + n);
         }
     }
 
@@ -72,33 +109,31 @@ public:
         const Matrix& matrix,
         const Vector2& col_vector) const noexcept
     {
-        detail::assign(first(result), last(result), detail::cpy(), precision_type(0.));
+        auto row = first(matrix);
+        const size_type width = matrix.shape().width;
 
-        for (size_type i = 0; i < result.size(); ++i)
-            for (size_type j = 0; j < col_vector.size(); ++j)
-                result(i) += matrix(i, j) * col_vector(j);
+        for (size_type i = 0; i < result.size(); ++i, row += width)
+            result(i) = detail::dot(row, row + width, first(col_vector));
     }
 
+    // lhs and rhs may be strided views, e.g. transposed matrices
     template <class Matrix1, class Matrix2, class Matrix3,
               meta::as_matrix<Matrix1> = 0,
-              meta::as_matrix<Matrix2> = 0,
-              meta::as_matrix<Matrix3> = 0>
+              meta::as_matrix_operand<Matrix2> = 0,
+              meta::as_matrix_operand<Matrix3> = 0>
     void dot(
         Matrix1& result,
         const Matrix2& lhs,
-        const Matrix3& rhs) const noexcept
+        const Matrix3& rhs,
+        bool accumulate = true) const noexcept
     {
-        precision_type buff;
-        for (size_type i = 0; i < lhs.shape().height; ++i)
-        {
-            for (size_type r = 0; r < lhs.shape().width; ++r)
-            {
-                buff = lhs(i, r);
-
-                for (size_type j = 0; j < rhs.shape().width; ++j)
-                    result(i, j) += buff * rhs(r, j);
-            }
-        }
+        // result += lhs . rhs, or result = lhs . rhs if not accumulate
+        detail::gemm(
+            lhs.shape().height, rhs.shape().width, lhs.shape().width,
+            lhs.data(), detail::row_stride(lhs), detail::col_stride(lhs),
+            rhs.data(), detail::row_stride(rhs), detail::col_stride(rhs),
+            result.data(), result.shape().width, 1, accumulate
+        );
     }
 
     template <class Vector1, class Vector2, class Matrix,
@@ -138,6 +173,71 @@ public:
         }
     }
 
+    // result += col_vector (x) row_vector
+    template <class Vector1, class Vector2, class Matrix,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0>
+    void tensordot_add(
+        Matrix& result,
+        const Vector1& col_vector,
+        const Vector2& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto row = first(result);
+        for (size_type i = 0; i < col_vector.size(); ++i, row += width)
+            detail::axpy(row, row + width, col_vector(i), first(row_vector));
+    }
+
+    // result = matrix . row_vector and accumulator += col_vector (x) row_vector,
+    // by single pass over rows of matrix and accumulator
+    template <class Vector1, class Vector2, class Vector3, class Matrix1, class Matrix2,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              as_flat_iterate<Vector3> = 0,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void dot_tensordot_add(
+        Vector1& result,
+        Matrix1& accumulator,
+        const Matrix2& matrix,
+        const Vector2& col_vector,
+        const Vector3& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto row = first(accumulator);
+        auto src = first(matrix);
+
+        for (size_type i = 0; i < result.size(); ++i, row += width, src += width)
+            result(i) = detail::axpy_dot(row, row + width, col_vector(i), first(row_vector), src);
+    }
+
+    // result = matrix . row_vector and target = col_vector (x) row_vector,
+    // by single pass over rows of matrix and target
+    template <class Vector1, class Vector2, class Vector3, class Matrix1, class Matrix2,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              as_flat_iterate<Vector3> = 0,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void dot_tensordot(
+        Vector1& result,
+        Matrix1& target,
+        const Matrix2& matrix,
+        const Vector2& col_vector,
+        const Vector3& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto row = first(target);
+        auto src = first(matrix);
+
+        for (size_type i = 0; i < result.size(); ++i, row += width, src += width)
+            result(i) = detail::mul_dot(row, row + width, col_vector(i), first(row_vector), src);
+    }
+
     template <class Matrix1, class Matrix2,
               meta::as_matrix<Matrix1> = 0,
               meta::as_matrix<Matrix2> = 0>
@@ -216,22 +316,7 @@ public:
         const Vector1& lhs,
         const Vector2& rhs) const noexcept
     {
-        precision_type result = 0.0;
-
-        auto first = lhs.data();
-        auto last  = lhs.data() + lhs.size();
-
-        auto data = rhs.data();
-
-        while (first != last)
-        {
-            result += (*first) * (*data);
-
-            ++first;
-            ++data;
-        }
-
-        return result;
+        return detail::dot(first(lhs), last(lhs), first(rhs));
     }
 
     template <class Vector, class Matrix, class VectorRet = Vector,
@@ -266,7 +351,7 @@ public:
 
     template <class Matrix1, class Matrix2, class MatrixRet = Matrix1,
               meta::as_matrix<Matrix1> = 0,
-              meta::as_matrix<Matrix2> = 0,
+              meta::as_matrix_operand<Matrix2> = 0,
               meta::as_matrix<MatrixRet> = 0>
     MatrixRet dot(
         const Matrix1& lhs,
@@ -433,6 +518,27 @@ public:
         detail::copy(first(lhs), last(lhs), first(rhs));
     }
 
+    // result = expression, by single pass, see lique::lazy
+    template <class Tensor, class Expression,
+              meta::as_iterate<Tensor> = 0,
+              meta::as_expression<Expression> = 0>
+    void assign(
+        Tensor& result,
+        const Expression& expression) const noexcept
+    {
+        detail::evaluate(first(result), 0, result.size(), expression);
+    }
+
+    // lets are evaluated by single pass, see lazy::let
+    template <class Let, class... Lets,
+              meta::as_let<Let, Lets...> = 0>
+    void fuse(
+        const Let& let,
+        const Lets&... lets) const noexcept
+    {
+        detail::fuse<typename Let::value_type>(0, let.size, let, lets...);
+    }
+
     template <class Tensor, class Function,
               meta::as_iterate<Tensor> = 0>
     void loop(
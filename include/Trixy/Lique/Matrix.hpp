@@ -6,6 +6,8 @@
 #include <Trixy/Lique/Base.hpp>
 #include <Trixy/Lique/TensorBase.hpp>
 
+#include <Trixy/Detail/MemoryDetail.hpp>
+
 #include <Trixy/Detail/TrixyMeta.hpp>
 
 #include <Trixy/Lique/Detail/MacroScope.hpp>
@@ -94,14 +96,14 @@ public:
 LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::~Tensor()
 {
-    delete[] this->data_;
+    trixy::detail::deallocate(this->data_);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(const shape_type& shape, const_pointer data)
     : Base(shape.depth * shape.height, shape.width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(data);
 }
@@ -110,7 +112,7 @@ LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(const shape_type& shape, precision_type value)
     : Base(shape.depth * shape.height, shape.width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->fill(value);
 }
@@ -119,14 +121,14 @@ LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(const shape_type& shape)
     : Base(shape.depth * shape.height, shape.width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(size_type height, size_type width, const_pointer data)
     : Base(height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(data);
 }
@@ -135,7 +137,7 @@ LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(size_type height, size_type width, precision_type value)
     : Base(height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->fill(value);
 }
@@ -144,14 +146,14 @@ LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(size_type height, size_type width)
     : Base(height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(const_pointer first, const_pointer last)
     : Base(1, last - first)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(first);
 }
@@ -160,7 +162,7 @@ LIQUE_TENSOR_TEMPLATE()
 Matrix<Precision>::Tensor(const Tensor& tensor)
     : Base(tensor.shape_.depth * tensor.shape_.height, tensor.shape_.width)
 {
-    this->data_ = new precision_type [tensor.shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
 
     this->copy(tensor.data_);
 }
@@ -176,9 +178,9 @@ Matrix<Precision>& Matrix<Precision>::operator= (const Tensor& tensor)
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
-        this->data_ = new precision_type [tensor.shape_.size];
+        this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
 
         this->copy(tensor.data_);
 
@@ -196,7 +198,7 @@ Matrix<Precision>& Matrix<Precision>::operator= (Tensor&& tensor) noexcept
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
         this->data_ = tensor.data_;
 
@@ -245,14 +247,11 @@ auto Matrix<Precision>::resize(const shape_type& shape) -> Tensor&
 LIQUE_TENSOR_TEMPLATE()
 auto Matrix<Precision>::resize(size_type height, size_type width) -> Tensor&
 {
-    delete[] this->data_;
-
-    this->shape_.height = height;
-    this->shape_.width = width;
+    trixy::detail::deallocate(this->data_);
 
-    this->shape_.size = height * width;
+    this->shape_ = shape_type(height, width);
 
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     return *this;
 }
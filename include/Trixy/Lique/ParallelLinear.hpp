@@ -0,0 +1,698 @@
+#ifndef TRIXY_LIQUE_PARALLEL_LINEAR_HPP
+#define TRIXY_LIQUE_PARALLEL_LINEAR_HPP
+
+#include <cstddef> // size_t
+#include <cmath> // fabs
+#include <mutex> // mutex, lock_guard
+#include <utility> // swap
+
+#include <Trixy/Lique/Linear.hpp>
+
+#include <Trixy/Lique/Detail/FunctionDetail.hpp>
+#include <Trixy/Lique/Detail/LiqueMeta.hpp>
+
+#include <Trixy/Thread/Core.hpp>
+
+#include <Trixy/Detail/MetaMacro.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+// Operations smaller than twice of the given work are executed by calling thread only
+struct ParallelSetting
+{
+    std::size_t min_per_thread = 1 << 15; // elements of element-wise operations
+    std::size_t min_dot_per_thread = 1 << 18; // multiply-add operations of products
+};
+
+namespace detail
+{
+
+// Shared by all parallel linear instances, includes calling thread
+inline utility::ThreadPool& parallel_pool()
+{
+    static utility::ThreadPool pool;
+    return pool;
+}
+
+inline ParallelSetting& parallel_setting() noexcept
+{
+    static ParallelSetting setting;
+    return setting;
+}
+
+} // namespace detail
+
+// Drop-in replacement of the Linear, that splits large operations across shared thread pool:
+// trixy::TypeSet<float, trixy::lique::ParallelLinear>
+template <typename Precision>
+class ParallelLinear : public Linear<Precision>
+{
+private:
+    using Base = Linear<Precision>;
+
+    template <class T>
+    using as_flat_iterate =
+        trixy::meta::require<not meta::is_matrix<T>::value and
+                             meta::is_iterate<T>::value>;
+
+public:
+    using typename Base::size_type;
+    using typename Base::precision_type;
+
+public:
+    using Base::first;
+    using Base::last;
+
+    using Base::loop;
+
+public:
+    static utility::ThreadPool& pool() { return detail::parallel_pool(); }
+    static ParallelSetting& setting() noexcept { return detail::parallel_setting(); }
+
+    template <class Vector1, class Vector2, class Matrix,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0>
+    void dot(
+        Vector1& result,
+        const Vector2& row_vector,
+        const Matrix& matrix) const noexcept
+    {
+        const size_type height = row_vector.size();
+        const size_type width = matrix.shape().width;
+
+        auto dst = first(result);
+        auto src = first(matrix);
+        auto x = first(row_vector);
+
+        // each thread owns block of result columns
+        parallel(width, min_per_block(height), [=](size_type begin, size_type end)
+        {
+            detail::assign(dst + begin, dst + end, detail::cpy(), precision_type(0.));
+
+            for (size_type i = 0; i < height; ++i)
+                detail::axpy(dst + begin, dst + end, x[i], src + i * width + begin);
+        });
+    }
+
+    template <class Vector1, class Vector2, class Matrix, class Vector3, class Function,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0,
+              as_flat_iterate<Vector3> = 0>
+    void dot(
+        Vector1& result,
+        const Vector2& row_vector,
+        const Matrix& matrix,
+        const Vector3& bias,
+        Function function) const TRNOEXCEPT_IF(noexcept(function))
+    {
+        const size_type height = row_vector.size();
+        const size_type width = matrix.shape().width;
+
+        auto dst = first(result);
+        auto src = first(matrix);
+        auto x = first(row_vector);
+        auto b = first(bias);
+
+        // each thread owns whole blocks of result columns
+        const size_type blocks = (width + detail::gevm_block - 1) / detail::gevm_block;
+
+        const bool is_streamed = height * width > detail::gevm_cache_size;
+
+        parallel(blocks, min_per_block(height * detail::gevm_block), [&](size_type begin, size_type end)
+        {
+            begin *= detail::gevm_block;
+            end = end * detail::gevm_block < width ? end * detail::gevm_block : width;
+
+            if (is_streamed)
+            {
+                detail::copy(dst + begin, dst + end, b + begin);
+
+                for (size_type i = 0; i < height; ++i)
+                    detail::axpy(dst + begin, dst + end, x[i], src + i * width + begin);
+            }
+
+            for (size_type j = begin; j < end; j += detail::gevm_block)
+            {
+                const size_type n = detail::gevm_block < end - j ? detail::gevm_block : end - j;
+
+                if (not is_streamed) detail::gevm(height, x, src + j, width, b + j, dst + j, n);
+                function(j, j + n);
+            }
+        });
+    }
+
+    template <class Vector1, class Vector2, class Matrix,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0>
+    void dot(
+        Vector1& result,
+        const Matrix& matrix,
+        const Vector2& col_vector) const noexcept
+    {
+        const size_type width = matrix.shape().width;
+
+        auto dst = first(result);
+        auto src = first(matrix);
+        auto x = first(col_vector);
+
+        parallel(result.size(), min_per_block(width), [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                dst[i] = detail::dot(src + i * width, src + (i + 1) * width, x);
+        });
+    }
+
+    template <class Matrix1, class Matrix2, class Matrix3,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix_operand<Matrix2> = 0,
+              meta::as_matrix_operand<Matrix3> = 0>
+    void dot(
+        Matrix1& result,
+        const Matrix2& lhs,
+        const Matrix3& rhs,
+        bool accumulate = true) const noexcept
+    {
+        // result += lhs . rhs, or result = lhs . rhs if not accumulate
+        const size_type m = lhs.shape().height;
+        const size_type n = rhs.shape().width;
+        const size_type k = lhs.shape().width;
+
+        const size_type a_rs = detail::row_stride(lhs);
+        const size_type a_cs = detail::col_stride(lhs);
+        const size_type b_rs = detail::row_stride(rhs);
+        const size_type b_cs = detail::col_stride(rhs);
+
+        auto a = lhs.data();
+        auto b = rhs.data();
+        auto c = result.data();
+
+        // split the larger side, so each thread still gets wide enough tiles
+        if (m >= n)
+        {
+            parallel(m, min_per_block(n * k), [=](size_type begin, size_type end)
+            {
+                detail::gemm(end - begin, n, k, a + begin * a_rs, a_rs, a_cs, b, b_rs, b_cs, c + begin * n, n, 1, accumulate);
+            });
+        }
+        else
+        {
+            parallel(n, min_per_block(m * k), [=](size_type begin, size_type end)
+            {
+                detail::gemm(m, end - begin, k, a, a_rs, a_cs, b + begin * b_cs, b_rs, b_cs, c + begin, n, 1, accumulate);
+            });
+        }
+    }
+
+    template <class Vector1, class Vector2, class Matrix,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0>
+    void tensordot(
+        Matrix& result,
+        const Vector1& col_vector,
+        const Vector2& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto dst = first(result);
+        auto x = first(col_vector);
+        auto y = first(row_vector);
+
+        parallel(col_vector.size(), min_per_block(width), [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                detail::assign(dst + i * width, dst + (i + 1) * width, detail::mul(), x[i], y);
+        });
+    }
+
+    template <class Vector1, class Vector2, class Matrix,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              meta::as_matrix<Matrix> = 0>
+    void tensordot_add(
+        Matrix& result,
+        const Vector1& col_vector,
+        const Vector2& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto dst = first(result);
+        auto x = first(col_vector);
+        auto y = first(row_vector);
+
+        parallel(col_vector.size(), min_per_block(width), [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                detail::axpy(dst + i * width, dst + (i + 1) * width, x[i], y);
+        });
+    }
+
+    template <class Vector1, class Vector2, class Vector3, class Matrix1, class Matrix2,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              as_flat_iterate<Vector3> = 0,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void dot_tensordot_add(
+        Vector1& result,
+        Matrix1& accumulator,
+        const Matrix2& matrix,
+        const Vector2& col_vector,
+        const Vector3& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto dst = first(result);
+        auto acc = first(accumulator);
+        auto src = first(matrix);
+        auto x = first(col_vector);
+        auto y = first(row_vector);
+
+        parallel(result.size(), min_per_block(2 * width), [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                dst[i] = detail::axpy_dot(acc + i * width, acc + (i + 1) * width, x[i], y, src + i * width);
+        });
+    }
+
+    template <class Vector1, class Vector2, class Vector3, class Matrix1, class Matrix2,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0,
+              as_flat_iterate<Vector3> = 0,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void dot_tensordot(
+        Vector1& result,
+        Matrix1& target,
+        const Matrix2& matrix,
+        const Vector2& col_vector,
+        const Vector3& row_vector) const noexcept
+    {
+        const size_type width = row_vector.size();
+
+        auto dst = first(result);
+        auto out = first(target);
+        auto src = first(matrix);
+        auto x = first(col_vector);
+        auto y = first(row_vector);
+
+        parallel(result.size(), min_per_block(2 * width), [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                dst[i] = detail::mul_dot(out + i * width, out + (i + 1) * width, x[i], y, src + i * width);
+        });
+    }
+
+    template <class Matrix1, class Matrix2,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void transpose(
+        Matrix1& result,
+        const Matrix2& matrix) const noexcept
+    {
+        const size_type height = result.shape().height;
+        const size_type width = result.shape().width;
+
+        auto dst = first(result);
+        auto src = first(matrix);
+
+        parallel(height, setting().min_per_thread / (width + 1) + 1, [=](size_type begin, size_type end)
+        {
+            for (size_type i = begin; i < end; ++i)
+                for (size_type j = 0; j < width; ++j)
+                    dst[i * width + j] = src[j * height + i];
+        });
+    }
+
+    template <class Matrix1, class Matrix2,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix<Matrix2> = 0>
+    void inverse(
+        Matrix1& result,
+        Matrix2& matrix) const noexcept
+    {
+        const size_type N = matrix.shape().height;
+
+        if (N * N < 2 * setting().min_dot_per_thread)
+        {
+            Base::inverse(result, matrix);
+            return;
+        }
+
+        auto a = first(matrix);
+        auto r = first(result);
+
+        for (size_type i = 0; i < N; ++i)
+            for (size_type j = 0; j < N; ++j)
+                r[i * N + j] = (i == j) ? 1. : 0.;
+
+        for (size_type k = 0; k < N; ++k)
+        {
+            size_type p = k;
+            for (size_type i = k + 1; i < N; ++i)
+                if (std::fabs(a[p * N + k]) < std::fabs(a[i * N + k]))
+                    p = i;
+
+            if (p != k)
+            {
+                for (size_type j = k; j < N; ++j) std::swap(a[k * N + j], a[p * N + j]);
+                for (size_type j = 0; j < N; ++j) std::swap(r[k * N + j], r[p * N + j]);
+            }
+
+            const precision_type pivot = 1. / a[k * N + k];
+
+            for (size_type j = k; j < N; ++j) a[k * N + j] *= pivot;
+            for (size_type j = 0; j < N; ++j) r[k * N + j] *= pivot;
+
+            // elimination of the other rows is independent for each of them
+            parallel(N, min_per_block(2 * N), [=](size_type begin, size_type end)
+            {
+                for (size_type i = begin; i < end; ++i)
+                {
+                    if (i == k) continue;
+
+                    const precision_type factor = a[i * N + k];
+
+                    for (size_type j = k; j < N; ++j) a[i * N + j] -= a[k * N + j] * factor;
+                    for (size_type j = 0; j < N; ++j) r[i * N + j] -= r[k * N + j] * factor;
+                }
+            });
+        }
+    }
+
+    template <class Vector1, class Vector2,
+              as_flat_iterate<Vector1> = 0,
+              as_flat_iterate<Vector2> = 0>
+    precision_type dot(
+        const Vector1& lhs,
+        const Vector2& rhs) const noexcept
+    {
+        auto x = first(lhs);
+        auto y = first(rhs);
+
+        precision_type result = 0.;
+        std::mutex mutex;
+
+        parallel(lhs.size(), setting().min_dot_per_thread, [&](size_type begin, size_type end)
+        {
+            const precision_type partial = detail::dot(x + begin, x + end, y + begin);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            result += partial;
+        });
+
+        return result;
+    }
+
+    template <class Vector, class Matrix, class VectorRet = Vector,
+              as_flat_iterate<Vector> = 0,
+              meta::as_matrix<Matrix> = 0,
+              as_flat_iterate<VectorRet> = 0>
+    VectorRet dot(
+        const Vector& row_vector,
+        const Matrix& matrix) const
+    {
+        Vector result(matrix.shape().width);
+
+        dot(result, row_vector, matrix);
+
+        return result;
+    }
+
+    template <class Vector, class Matrix, class VectorRet = Vector,
+              as_flat_iterate<Vector> = 0,
+              meta::as_matrix<Matrix> = 0,
+              as_flat_iterate<VectorRet> = 0>
+    VectorRet dot(
+        const Matrix& matrix,
+        const Vector& col_vector) const
+    {
+        Vector result(matrix.shape().height);
+
+        dot(result, matrix, col_vector);
+
+        return result;
+    }
+
+    template <class Matrix1, class Matrix2, class MatrixRet = Matrix1,
+              meta::as_matrix<Matrix1> = 0,
+              meta::as_matrix_operand<Matrix2> = 0,
+              meta::as_matrix<MatrixRet> = 0>
+    MatrixRet dot(
+        const Matrix1& lhs,
+        const Matrix2& rhs) const
+    {
+        MatrixRet matrix(lhs.shape().height, rhs.shape().width, 0.);
+
+        dot(matrix, lhs, rhs);
+
+        return matrix;
+    }
+
+    template <class MatrixRet, class Vector,
+              meta::as_matrix<MatrixRet> = 0,
+              as_flat_iterate<Vector> = 0>
+    MatrixRet tensordot(
+        const Vector& col_vector,
+        const Vector& row_vector) const
+    {
+        MatrixRet result(col_vector.size(), row_vector.size());
+
+        tensordot(result, col_vector, row_vector);
+
+        return result;
+    }
+
+    template <class Matrix, class MatrixRet = Matrix,
+              meta::as_matrix<Matrix> = 0,
+              meta::as_matrix<MatrixRet> = 0>
+    MatrixRet transpose(const Matrix& matrix) const
+    {
+        MatrixRet result(matrix.shape().width, matrix.shape().height);
+
+        transpose(result, matrix);
+
+        return result;
+    }
+
+    template <class Matrix, class MatrixRet = Matrix,
+              meta::as_matrix<Matrix> = 0,
+              meta::as_matrix<MatrixRet> = 0>
+    MatrixRet inverse(Matrix& matrix) const
+    {
+        MatrixRet result(matrix.shape());
+
+        inverse(result, matrix);
+
+        return result;
+    }
+
+    template <class Tensor1, class Tensor2,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void add(
+        Tensor1& result,
+        const Tensor2& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::add(), first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2, class Tensor3,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0,
+              meta::as_iterate<Tensor3> = 0>
+    void add(
+        Tensor1& result,
+        const Tensor2& lhs,
+        const Tensor3& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::add(),
+                           first(lhs) + begin, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void sub(
+        Tensor1& result,
+        const Tensor2& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::sub(), first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2, class Tensor3,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0,
+              meta::as_iterate<Tensor3> = 0>
+    void sub(
+        Tensor1& result,
+        const Tensor2& lhs,
+        const Tensor3& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::sub(),
+                           first(lhs) + begin, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void mul(
+        Tensor1& result,
+        const Tensor2& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::mul(), first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2, class Tensor3,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0,
+              meta::as_iterate<Tensor3> = 0>
+    void mul(
+        Tensor1& result,
+        const Tensor2& lhs,
+        const Tensor3& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::mul(),
+                           first(lhs) + begin, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1,
+              meta::as_iterate<Tensor1> = 0>
+    void join(
+        Tensor1& result,
+        precision_type value) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::mul(), value);
+        });
+    }
+
+    template <class Tensor1, class Tensor2,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void join(
+        Tensor1& result,
+        precision_type value,
+        const Tensor2& rhs) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::assign(first(result) + begin, first(result) + end, detail::mul(), value, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor, class Function,
+              meta::as_iterate<Tensor> = 0>
+    void apply(
+        Tensor& result,
+        Function func) const TRNOEXCEPT_IF(noexcept(func))
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::apply(first(result) + begin, first(result) + end, func);
+        });
+    }
+
+    template <class Tensor1, class Tensor2, class Function,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void apply(
+        Tensor1& result,
+        Function func,
+        const Tensor2& rhs) const TRNOEXCEPT_IF(noexcept(func))
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::apply(first(result) + begin, first(result) + end, func, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor1, class Tensor2,
+              meta::as_iterate<Tensor1> = 0,
+              meta::as_iterate<Tensor2> = 0>
+    void assign(
+        Tensor1& lhs,
+        const Tensor2& rhs) const noexcept
+    {
+        elementwise(lhs, [&](size_type begin, size_type end)
+        {
+            detail::copy(first(lhs) + begin, first(lhs) + end, first(rhs) + begin);
+        });
+    }
+
+    template <class Tensor, class Expression,
+              meta::as_iterate<Tensor> = 0,
+              meta::as_expression<Expression> = 0>
+    void assign(
+        Tensor& result,
+        const Expression& expression) const noexcept
+    {
+        elementwise(result, [&](size_type begin, size_type end)
+        {
+            detail::evaluate(first(result), begin, end, expression);
+        });
+    }
+
+    template <class Let, class... Lets,
+              meta::as_let<Let, Lets...> = 0>
+    void fuse(
+        const Let& let,
+        const Lets&... lets) const noexcept
+    {
+        parallel(let.size, setting().min_per_thread, [&](size_type begin, size_type end)
+        {
+            detail::fuse<typename Let::value_type>(begin, end, let, lets...);
+        });
+    }
+
+private:
+    template <class Function>
+    void parallel(size_type size, size_type min_per_thread, Function function) const
+    {
+        pool().parallel_for(size, min_per_thread, function);
+    }
+
+    template <class Tensor, class Function>
+    void elementwise(Tensor& result, Function function) const
+    {
+        parallel(result.size(), setting().min_per_thread, function);
+    }
+
+    // number of rows/columns per thread, when each of them costs 'work' multiply-add operations
+    static size_type min_per_block(size_type work) noexcept
+    {
+        return setting().min_dot_per_thread / (work + 1) + 1;
+    }
+};
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_PARALLEL_LINEAR_HPP
@@ -43,12 +43,47 @@ public:
     : depth(1), height(1), width(w), size(w) {}
 };
 
+// Shape of batch of samples with the same 3-D shape
+template <typename T>
+struct BatchShape
+{
+private:
+    static constexpr bool require = std::is_integral<T>::value;
+
+    static_assert(require, "'T' should be an integral type.");
+
+public:
+    using size_type = T;
+
+public:
+    size_type batch;
+    size_type depth;
+    size_type height;
+    size_type width;
+
+    size_type size;
+
+public:
+    BatchShape() : batch(0), depth(0), height(0), width(0), size(0) {}
+
+    explicit BatchShape(size_type n, size_type d, size_type h, size_type w)
+    : batch(n), depth(d), height(h), width(w), size(n * d * h * w) {}
+
+    explicit BatchShape(size_type n, const Shape<T>& sample)
+    : BatchShape(n, sample.depth, sample.height, sample.width) {}
+
+    Shape<T> sample() const noexcept { return Shape<T>(depth, height, width); }
+};
+
 namespace meta
 {
 
 template <typename T> struct is_shape : std::false_type {};
 template <typename T> struct is_shape<Shape<T>> : std::true_type {};
 
+template <typename T> struct is_batch_shape : std::false_type {};
+template <typename T> struct is_batch_shape<BatchShape<T>> : std::true_type {};
+
 } // namespace meta
 
 } // namespace lique
@@ -60,4 +95,9 @@ CONDITIONAL_SERIALIZATION(saveload, shape, trixy::lique::meta::is_shape<S>::valu
     archive & shape.depth & shape.height & shape.width & shape.size;
 }
 
+CONDITIONAL_SERIALIZATION(saveload, shape, trixy::lique::meta::is_batch_shape<S>::value)
+{
+    archive & shape.batch & shape.depth & shape.height & shape.width & shape.size;
+}
+
 #endif // TRIXY_LIQUE_SHAPE_HPP
@@ -0,0 +1,271 @@
+#ifndef TRIXY_LIQUE_STRIDED_HPP
+#define TRIXY_LIQUE_STRIDED_HPP
+
+#include <cstddef> // size_t
+#include <type_traits> // remove_const, is_const
+#include <utility> // swap
+
+#include <Trixy/Lique/Base.hpp>
+#include <Trixy/Lique/TensorBase.hpp>
+
+#include <Trixy/Lique/Shape.hpp>
+
+#include <Trixy/Lique/Detail/LiqueMeta.hpp>
+
+#include <Trixy/Detail/MetaMacro.hpp>
+#include <Trixy/Lique/Detail/MacroScope.hpp>
+
+namespace trixy
+{
+
+namespace lique
+{
+
+// Distance in elements between neighbours along each dimension
+template <typename T>
+struct Stride
+{
+public:
+    using size_type = T;
+
+public:
+    size_type depth;
+    size_type height;
+    size_type width;
+
+public:
+    Stride() : depth(0), height(0), width(0) {}
+
+    explicit Stride(size_type d, size_type h, size_type w)
+    : depth(d), height(h), width(w) {}
+
+    // Stride of dense row-major tensor of given shape
+    explicit Stride(const Shape<T>& shape)
+    : depth(shape.height * shape.width), height(shape.width), width(1) {}
+};
+
+// Non-owning view with per-dimension strides, used for zero-copy slicing and transposition,
+// should not outlive viewed tensor; view of const tensor has const Precision, e.g. StridedView<const float>
+LIQUE_TENSOR_TEMPLATE()
+using StridedView = Tensor<Precision, TensorType::strided, TensorMode::view>;
+
+LIQUE_TENSOR_TEMPLATE()
+class Tensor<Precision, TensorType::strided, TensorMode::view> : public TensorType::strided
+{
+public:
+    using size_type         = std::size_t;
+    using precision_type    = Precision;
+    using value_type        = Precision;
+    using shape_type        = Shape<std::size_t>;
+    using stride_type       = Stride<std::size_t>;
+
+    using pointer           = Precision*;
+    using const_pointer     = const Precision*;
+
+    using reference         = Precision&;
+    using const_reference   = const Precision&;
+
+private:
+    using element_type      = typename std::remove_const<Precision>::type;
+
+protected:
+    pointer data_;
+    shape_type shape_;
+    stride_type stride_;
+
+public:
+    Tensor() noexcept;
+
+    Tensor(const shape_type& shape, const stride_type& stride, pointer data) noexcept;
+
+    // view of dense tensor, matrix or vector
+    Tensor(TensorBase<element_type>& tensor) noexcept;
+
+    template <typename T = Precision, trixy::meta::require<std::is_const<T>::value> = 0>
+    Tensor(const TensorBase<element_type>& tensor) noexcept;
+
+    pointer data() noexcept;
+    const_pointer data() const noexcept;
+
+    size_type size() const noexcept;
+
+    const shape_type& shape() const noexcept;
+    const stride_type& stride() const noexcept;
+
+    bool contiguous() const noexcept;
+
+    Tensor channels(size_type first, size_type last) const noexcept;
+    Tensor rows(size_type first, size_type last) const noexcept;
+    Tensor cols(size_type first, size_type last) const noexcept;
+
+    Tensor transpose() const noexcept;
+
+    pointer at(size_type k, size_type i, size_type j) noexcept;
+    const_pointer at(size_type k, size_type i, size_type j) const noexcept;
+
+    pointer at(size_type i, size_type j) noexcept;
+    const_pointer at(size_type i, size_type j) const noexcept;
+
+    reference operator() (size_type k, size_type i, size_type j) noexcept;
+    const_reference operator() (size_type k, size_type i, size_type j) const noexcept;
+
+    reference operator() (size_type i, size_type j) noexcept;
+    const_reference operator() (size_type i, size_type j) const noexcept;
+};
+
+LIQUE_TENSOR_TEMPLATE()
+StridedView<Precision>::Tensor() noexcept : data_(nullptr), shape_(0, 0, 0), stride_() {}
+
+LIQUE_TENSOR_TEMPLATE()
+StridedView<Precision>::Tensor(const shape_type& shape, const stride_type& stride, pointer data) noexcept
+: data_(data), shape_(shape), stride_(stride) {}
+
+LIQUE_TENSOR_TEMPLATE()
+StridedView<Precision>::Tensor(TensorBase<element_type>& tensor) noexcept
+: data_(tensor.data()), shape_(tensor.shape()), stride_(tensor.shape()) {}
+
+LIQUE_TENSOR_TEMPLATE()
+template <typename T, trixy::meta::require<std::is_const<T>::value>>
+StridedView<Precision>::Tensor(const TensorBase<element_type>& tensor) noexcept
+: data_(tensor.data()), shape_(tensor.shape()), stride_(tensor.shape()) {}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::data() noexcept -> pointer
+{
+    return data_;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::data() const noexcept -> const_pointer
+{
+    return data_;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::size() const noexcept -> size_type
+{
+    return shape_.size;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::shape() const noexcept -> const shape_type&
+{
+    return shape_;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::stride() const noexcept -> const stride_type&
+{
+    return stride_;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+bool StridedView<Precision>::contiguous() const noexcept
+{
+    // dimensions of size 1 do not affect layout
+    return (shape_.width < 2 or stride_.width == 1)
+       and (shape_.height < 2 or stride_.height == shape_.width)
+       and (shape_.depth < 2 or stride_.depth == shape_.height * shape_.width);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto StridedView<Precision>::channels(size_type first, size_type last) const noexcept -> Tensor
+{
+    return Tensor(shape_type(last - first, shape_.height, shape_.width), stride_, data_ + first * stride_.depth);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto StridedView<Precision>::rows(size_type first, size_type last) const noexcept -> Tensor
+{
+    return Tensor(shape_type(shape_.depth, last - first, shape_.width), stride_, data_ + first * stride_.height);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto StridedView<Precision>::cols(size_type first, size_type last) const noexcept -> Tensor
+{
+    return Tensor(shape_type(shape_.depth, shape_.height, last - first), stride_, data_ + first * stride_.width);
+}
+
+LIQUE_TENSOR_TEMPLATE()
+auto StridedView<Precision>::transpose() const noexcept -> Tensor
+{
+    // swaps last two dimensions of each channel
+    return Tensor(
+        shape_type(shape_.depth, shape_.width, shape_.height),
+        stride_type(stride_.depth, stride_.width, stride_.height),
+        data_
+    );
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::at(size_type k, size_type i, size_type j) noexcept -> pointer
+{
+    return data_ + k * stride_.depth + i * stride_.height + j * stride_.width;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::at(size_type k, size_type i, size_type j) const noexcept -> const_pointer
+{
+    return data_ + k * stride_.depth + i * stride_.height + j * stride_.width;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::at(size_type i, size_type j) noexcept -> pointer
+{
+    return data_ + i * stride_.height + j * stride_.width;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::at(size_type i, size_type j) const noexcept -> const_pointer
+{
+    return data_ + i * stride_.height + j * stride_.width;
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::operator() (size_type k, size_type i, size_type j) noexcept -> reference
+{
+    return *at(k, i, j); // dereferencing
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::operator() (size_type k, size_type i, size_type j) const noexcept -> const_reference
+{
+    return *at(k, i, j); // dereferencing
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::operator() (size_type i, size_type j) noexcept -> reference
+{
+    return *at(i, j); // dereferencing
+}
+
+LIQUE_TENSOR_TEMPLATE()
+inline auto StridedView<Precision>::operator() (size_type i, size_type j) const noexcept -> const_reference
+{
+    return *at(i, j); // dereferencing
+}
+
+namespace detail
+{
+
+// Row and column strides of matrix operand in elements
+
+template <class Matrix, meta::as_matrix<Matrix> = 0>
+inline std::size_t row_stride(const Matrix& matrix) noexcept { return matrix.shape().width; }
+
+template <class Matrix, meta::as_matrix<Matrix> = 0>
+inline std::size_t col_stride(const Matrix&) noexcept { return 1; }
+
+template <class Matrix, meta::as_strided<Matrix> = 0>
+inline std::size_t row_stride(const Matrix& matrix) noexcept { return matrix.stride().height; }
+
+template <class Matrix, meta::as_strided<Matrix> = 0>
+inline std::size_t col_stride(const Matrix& matrix) noexcept { return matrix.stride().width; }
+
+} // namespace detail
+
+} // namespace lique
+
+} // namespace trixy
+
+#endif // TRIXY_LIQUE_STRIDED_HPP
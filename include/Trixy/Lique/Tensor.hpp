@@ -6,6 +6,8 @@
 #include <Trixy/Lique/Base.hpp>
 #include <Trixy/Lique/TensorBase.hpp>
 
+#include <Trixy/Detail/MemoryDetail.hpp>
+
 #include <Trixy/Lique/Detail/MacroScope.hpp>
 
 namespace trixy
@@ -91,14 +93,14 @@ public:
 LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::~Tensor()
 {
-    delete[] this->data_;
+    trixy::detail::deallocate(this->data_);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(const shape_type& shape, const_pointer data)
     : Base(shape)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(data);
 }
@@ -107,7 +109,7 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(const shape_type& shape, precision_type value)
     : Base(shape)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->fill(value);
 }
@@ -116,14 +118,14 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(const shape_type& shape)
     : Base(shape)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(size_type depth, size_type height, size_type width, const_pointer data)
     : Base(depth, height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(data);
 }
@@ -132,7 +134,7 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(size_type depth, size_type height, size_type width, precision_type value)
     : Base(depth, height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->fill(value);
 }
@@ -141,14 +143,14 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(size_type depth, size_type height, size_type width)
     : Base(depth, height, width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(const_pointer first, const_pointer last)
     : Base(1, 1, last - first)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(first);
 }
@@ -157,7 +159,7 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(std::initializer_list<precision_type> list)
     : Base(1, 1, list.size())
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(list.begin());
 }
@@ -166,7 +168,7 @@ LIQUE_TENSOR_TEMPLATE()
 Tensor<Precision>::Tensor(const Tensor& tensor)
     : Base(tensor.shape_)
 {
-    this->data_ = new precision_type [tensor.shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
     this->shape_ = tensor.shape_;
 
     this->copy(tensor.data_);
@@ -183,9 +185,9 @@ Tensor<Precision>& Tensor<Precision>::operator= (const Tensor& tensor)
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
-        this->data_ = new precision_type [tensor.shape_.size];
+        this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
 
         this->copy(tensor.data_);
 
@@ -200,7 +202,7 @@ Tensor<Precision>& Tensor<Precision>::operator= (Tensor&& tensor) noexcept
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
         this->data_ = tensor.data_;
         this->shape_ = tensor.shape_;
@@ -249,11 +251,11 @@ auto Tensor<Precision>::resize(const shape_type& shape) -> Tensor&
 LIQUE_TENSOR_TEMPLATE()
 auto Tensor<Precision>::resize(size_type depth, size_type height, size_type width) -> Tensor&
 {
-    delete[] this->data_;
+    trixy::detail::deallocate(this->data_);
 
     this->shape_ = shape_type(depth, height, width);
 
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     return *this;
 }
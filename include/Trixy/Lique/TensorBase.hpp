@@ -11,6 +11,7 @@
 #include <Trixy/Range/View.hpp>
 
 #include <Trixy/Lique/Detail/FunctionDetail.hpp>
+#include <Trixy/Detail/MemoryDetail.hpp>
 
 #include <Trixy/Detail/TrixyMeta.hpp>
 #include <Trixy/Lique/Detail/LiqueMeta.hpp>
@@ -459,7 +460,23 @@ inline auto TensorBase<Precision>::operator() (size_type i) const noexcept -> co
 CONDITIONAL_SERIALIZATION(saveload, tensor, trixy::lique::meta::is_tensor_type<S>::value)
 {
     archive & tensor.shape_;
-    archive & sf::span(tensor.data_, tensor.shape_.size);
+
+    if (trixy::meta::is_iarchive(archive) and trixy::lique::meta::is_own_tensor<S>::value)
+    {
+        // loaded data is allocated by archive, but owned data of tensor should be aligned
+        typename S::pointer data = nullptr;
+        archive & sf::span(data, tensor.shape_.size);
+
+        trixy::detail::deallocate(tensor.data_);
+        tensor.data_ = trixy::detail::allocate<typename S::precision_type>(tensor.shape_.size);
+
+        trixy::lique::detail::copy(tensor.data_, tensor.data_ + tensor.shape_.size, data);
+        delete[] data;
+    }
+    else
+    {
+        archive & sf::span(tensor.data_, tensor.shape_.size);
+    }
 }
 
 #endif // TRIXY_LIQUE_BASE_TENSOR_HPP
@@ -7,6 +7,8 @@
 #include <Trixy/Lique/Base.hpp>
 #include <Trixy/Lique/TensorBase.hpp>
 
+#include <Trixy/Detail/MemoryDetail.hpp>
+
 #include <Trixy/Detail/TrixyMeta.hpp>
 
 #include <Trixy/Lique/Detail/MacroScope.hpp>
@@ -85,14 +87,14 @@ public:
 LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::~Tensor()
 {
-    delete[] this->data_;
+    trixy::detail::deallocate(this->data_);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(const shape_type& shape, const_pointer data)
     : Base(shape.width)
 {
-    this->data = new precision_type [shape.size];
+    this->data = trixy::detail::allocate<precision_type>(shape.size);
 
     this->copy(data);
 }
@@ -101,7 +103,7 @@ LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(const shape_type& shape, precision_type value)
     : Base(shape.width)
 {
-    this->data = new precision_type [shape.size];
+    this->data = trixy::detail::allocate<precision_type>(shape.size);
 
     this->fill(value);
 }
@@ -110,14 +112,14 @@ LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(const shape_type& shape)
     : Base(shape.width)
 {
-    this->data = new precision_type [shape.size];
+    this->data = trixy::detail::allocate<precision_type>(shape.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(std::initializer_list<precision_type> init)
     : Base(init.size())
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(init.begin());
 }
@@ -126,7 +128,7 @@ LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(size_type width, const_pointer data)
     : Base(width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(data);
 }
@@ -135,7 +137,7 @@ LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(size_type width, precision_type value)
     : Base(width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->fill(value);
 }
@@ -144,14 +146,14 @@ LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(size_type width)
     : Base(width)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 }
 
 LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(const_pointer first, const_pointer last)
     : Base(last - first)
 {
-    this->data_ = new precision_type [this->shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(this->shape_.size);
 
     this->copy(first);
 }
@@ -159,7 +161,7 @@ Vector<Precision>::Tensor(const_pointer first, const_pointer last)
 LIQUE_TENSOR_TEMPLATE()
 Vector<Precision>::Tensor(const Tensor& tensor) : Base(tensor.shape_.width)
 {
-    this->data_ = new precision_type [tensor.shape_.size];
+    this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
 
     this->copy(tensor.data_);
 }
@@ -175,9 +177,9 @@ Vector<Precision>& Vector<Precision>::operator= (const Tensor& tensor)
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
-        this->data_ = new precision_type [tensor.shape_.size];
+        this->data_ = trixy::detail::allocate<precision_type>(tensor.shape_.size);
 
         this->shape_.width = tensor.shape_.width;
         this->shape_.size = tensor.shape_.size;
@@ -193,7 +195,7 @@ Vector<Precision>& Vector<Precision>::operator= (Tensor&& tensor) noexcept
 {
     if (this != &tensor)
     {
-        delete[] this->data_;
+        trixy::detail::deallocate(this->data_);
 
         this->data_ = tensor.data_;
 
@@ -216,11 +218,11 @@ auto Vector<Precision>::resize(const shape_type& shape) -> Tensor&
 LIQUE_TENSOR_TEMPLATE()
 auto Vector<Precision>::resize(size_type width) -> Tensor&
 {
-    delete[] this->data_;
+    trixy::detail::deallocate(this->data_);
 
     this->shape_ = shape_type(1, width, 1);
 
-    this->data_ = new precision_type [width];
+    this->data_ = trixy::detail::allocate<precision_type>(width);
 
     return *this;
 }
@@ -0,0 +1,122 @@
+#ifndef TRIXY_MEMORY_ARENA_HPP
+#define TRIXY_MEMORY_ARENA_HPP
+
+#include <cstddef> // size_t
+#include <mutex> // mutex, lock_guard
+#include <vector> // vector
+
+#include <Trixy/Memory/Base.hpp>
+
+namespace trixy
+{
+
+namespace memory
+{
+
+// Bump arena: blocks are carved sequentially from large chunks and are never released one by one,
+// all of them are reclaimed at once by reset, tensors allocated by arena should not outlive reset
+class ArenaAllocator : public IAllocator
+{
+public:
+    using size_type = std::size_t;
+
+private:
+    struct Chunk
+    {
+        char* data;
+        size_type size;
+    };
+
+private:
+    IAllocator& upstream_;
+    size_type chunk_size_;
+
+    std::vector<Chunk> chunks_;
+    size_type chunk_;  // index of current chunk
+    size_type offset_; // offset in current chunk
+
+    std::mutex mutex_;
+
+public:
+    explicit ArenaAllocator(size_type chunk_size = size_type(1) << 20,
+                            IAllocator& upstream = default_allocator())
+        : upstream_(upstream), chunk_size_(chunk_size), chunk_(0), offset_(0)
+    {
+    }
+
+    ~ArenaAllocator() { release(); }
+
+    // Reuses all chunks from the beginning
+    void reset() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        chunk_ = 0;
+        offset_ = 0;
+    }
+
+    // Returns all chunks to upstream allocator
+    void release() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto& chunk : chunks_)
+            upstream_.deallocate(chunk.data, chunk.size);
+
+        chunks_.clear();
+
+        chunk_ = 0;
+        offset_ = 0;
+    }
+
+protected:
+    void* do_allocate(size_type bytes) override
+    {
+        // keeps next block aligned
+        bytes = (bytes + trixy::detail::alignment - 1) / trixy::detail::alignment * trixy::detail::alignment;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        while (chunk_ < chunks_.size() and offset_ + bytes > chunks_[chunk_].size)
+        {
+            ++chunk_;
+            offset_ = 0;
+        }
+
+        if (chunk_ == chunks_.size())
+        {
+            const size_type size = bytes > chunk_size_ ? bytes : chunk_size_;
+            chunks_.push_back({ static_cast<char*>(upstream_.allocate(size)), size });
+
+            offset_ = 0;
+        }
+
+        void* block = chunks_[chunk_].data + offset_;
+        offset_ += bytes;
+
+        return block;
+    }
+
+    void do_deallocate(void*, size_type) noexcept override {}
+};
+
+// Binds arena to current thread and resets it at the end of the scope
+class ArenaScope : public AllocatorScope
+{
+private:
+    ArenaAllocator& arena_;
+
+public:
+    explicit ArenaScope(ArenaAllocator& arena) noexcept
+        : AllocatorScope(arena), arena_(arena)
+    {
+    }
+
+    ~ArenaScope() { arena_.reset(); }
+};
+
+} // namespace memory
+
+} // namespace trixy
+
+#endif // TRIXY_MEMORY_ARENA_HPP
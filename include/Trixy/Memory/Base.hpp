@@ -0,0 +1,152 @@
+#ifndef TRIXY_MEMORY_BASE_HPP
+#define TRIXY_MEMORY_BASE_HPP
+
+#include <cstddef> // size_t
+#include <atomic> // atomic
+#include <new> // operator new, operator delete, align_val_t
+
+// Alignment in bytes of memory owned by tensors and unified ranges, should be power of 2,
+// default value is size of cache line and of avx512 register
+#ifndef TRIXY_ALIGNMENT
+    #define TRIXY_ALIGNMENT 64
+#endif
+
+namespace trixy
+{
+
+namespace detail
+{
+
+constexpr std::size_t alignment = TRIXY_ALIGNMENT;
+
+static_assert((alignment & (alignment - 1)) == 0, "'TRIXY_ALIGNMENT' should be power of 2.");
+
+} // namespace detail
+
+namespace memory
+{
+
+struct AllocatorStat
+{
+    std::size_t in_use = 0; // bytes
+    std::size_t peak = 0; // bytes
+    std::size_t count = 0; // number of allocations
+};
+
+// Source of aligned blocks for tensors and unified ranges,
+// block should be released by the same allocator that returned it
+class IAllocator
+{
+private:
+    std::atomic<std::size_t> in_use_{0};
+    std::atomic<std::size_t> peak_{0};
+    std::atomic<std::size_t> count_{0};
+
+public:
+    IAllocator() = default;
+    virtual ~IAllocator() = default;
+
+    IAllocator(const IAllocator&) = delete;
+    IAllocator& operator= (const IAllocator&) = delete;
+
+    void* allocate(std::size_t bytes)
+    {
+        void* block = do_allocate(bytes);
+
+        const std::size_t in_use = in_use_.fetch_add(bytes) + bytes;
+        count_.fetch_add(1);
+
+        std::size_t peak = peak_.load();
+        while (peak < in_use and not peak_.compare_exchange_weak(peak, in_use)) {}
+
+        return block;
+    }
+
+    void deallocate(void* block, std::size_t bytes) noexcept
+    {
+        in_use_.fetch_sub(bytes);
+        do_deallocate(block, bytes);
+    }
+
+    AllocatorStat stat() const noexcept
+    {
+        AllocatorStat stat;
+        stat.in_use = in_use_.load();
+        stat.peak = peak_.load();
+        stat.count = count_.load();
+
+        return stat;
+    }
+
+protected:
+    // should return block aligned to trixy::detail::alignment
+    virtual void* do_allocate(std::size_t bytes) = 0;
+    virtual void do_deallocate(void* block, std::size_t bytes) noexcept = 0;
+};
+
+// Global aligned new/delete
+class HeapAllocator : public IAllocator
+{
+protected:
+    void* do_allocate(std::size_t bytes) override
+    {
+        return ::operator new(bytes, std::align_val_t(trixy::detail::alignment));
+    }
+
+    void do_deallocate(void* block, std::size_t) noexcept override
+    {
+        ::operator delete(block, std::align_val_t(trixy::detail::alignment));
+    }
+};
+
+inline IAllocator& default_allocator() noexcept
+{
+    static HeapAllocator allocator;
+    return allocator;
+}
+
+namespace detail
+{
+
+inline IAllocator*& bound_allocator() noexcept
+{
+    thread_local IAllocator* allocator = &default_allocator();
+    return allocator;
+}
+
+} // namespace detail
+
+// Allocator of tensors and unified ranges created by current thread
+inline IAllocator& current_allocator() noexcept
+{
+    return *detail::bound_allocator();
+}
+
+// Binds allocator to current thread for lifetime of the scope,
+// memory is always returned to allocator that gave it, regardless of bound one
+class AllocatorScope
+{
+private:
+    IAllocator* previous_;
+
+public:
+    explicit AllocatorScope(IAllocator& allocator) noexcept
+        : previous_(detail::bound_allocator())
+    {
+        detail::bound_allocator() = &allocator;
+    }
+
+    ~AllocatorScope()
+    {
+        detail::bound_allocator() = previous_;
+    }
+
+    AllocatorScope(const AllocatorScope&) = delete;
+    AllocatorScope& operator= (const AllocatorScope&) = delete;
+};
+
+} // namespace memory
+
+} // namespace trixy
+
+#endif // TRIXY_MEMORY_BASE_HPP
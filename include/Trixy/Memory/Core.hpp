@@ -0,0 +1,9 @@
+#ifndef TRIXY_MEMORY_CORE_HPP
+#define TRIXY_MEMORY_CORE_HPP
+
+#include <Trixy/Memory/Base.hpp>
+
+#include <Trixy/Memory/Pool.hpp>
+#include <Trixy/Memory/Arena.hpp>
+
+#endif // TRIXY_MEMORY_CORE_HPP
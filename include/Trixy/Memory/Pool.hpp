@@ -0,0 +1,116 @@
+#ifndef TRIXY_MEMORY_POOL_HPP
+#define TRIXY_MEMORY_POOL_HPP
+
+#include <cstddef> // size_t
+#include <mutex> // mutex, lock_guard
+#include <new> // placement new
+#include <vector> // vector
+
+#include <Trixy/Memory/Base.hpp>
+
+namespace trixy
+{
+
+namespace memory
+{
+
+// Size-class pool: blocks are rounded up to power of 2 and kept in free lists after release,
+// free list is linked through released blocks themselves, so release never allocates,
+// blocks bigger than max_block go directly to upstream allocator,
+// pool should outlive all tensors allocated by it
+class PoolAllocator : public IAllocator
+{
+public:
+    using size_type = std::size_t;
+
+private:
+    static constexpr size_type min_block = trixy::detail::alignment;
+
+    // placed at the beginning of free block
+    struct Node
+    {
+        Node* next;
+    };
+
+    static_assert(min_block >= sizeof(Node), "Free block should hold link to the next one.");
+
+private:
+    IAllocator& upstream_;
+    size_type max_block_;
+
+    std::vector<Node*> free_; // head of free list of each size class
+    std::mutex mutex_;
+
+public:
+    explicit PoolAllocator(size_type max_block = size_type(1) << 24,
+                           IAllocator& upstream = default_allocator())
+        : upstream_(upstream), max_block_(max_block), free_(size_class(max_block) + 1, nullptr)
+    {
+    }
+
+    ~PoolAllocator() { release(); }
+
+    // Returns cached free blocks to upstream allocator
+    void release() noexcept
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (size_type i = 0; i < free_.size(); ++i)
+        {
+            while (free_[i] != nullptr)
+            {
+                Node* node = free_[i];
+                free_[i] = node->next;
+
+                upstream_.deallocate(node, min_block << i);
+            }
+        }
+    }
+
+protected:
+    void* do_allocate(size_type bytes) override
+    {
+        if (bytes > max_block_) return upstream_.allocate(bytes);
+
+        const size_type i = size_class(bytes);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            if (free_[i] != nullptr)
+            {
+                Node* node = free_[i];
+                free_[i] = node->next;
+
+                return node;
+            }
+        }
+
+        return upstream_.allocate(min_block << i);
+    }
+
+    void do_deallocate(void* block, size_type bytes) noexcept override
+    {
+        if (bytes > max_block_) return upstream_.deallocate(block, bytes);
+
+        const size_type i = size_class(bytes);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_[i] = ::new (block) Node{ free_[i] };
+    }
+
+private:
+    // index of the smallest block of size min_block * 2^i that is not less than bytes
+    static size_type size_class(size_type bytes) noexcept
+    {
+        size_type i = 0;
+        while ((min_block << i) < bytes) ++i;
+
+        return i;
+    }
+};
+
+} // namespace memory
+
+} // namespace trixy
+
+#endif // TRIXY_MEMORY_POOL_HPP
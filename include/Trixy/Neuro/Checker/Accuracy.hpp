@@ -2,6 +2,11 @@
 #define TRIXY_NEURO_CHECKER_ACCURACY_HPP
 
 #include <cmath> // fabs
+#include <utility> // declval
+
+#include <Trixy/Lique/Vector.hpp>
+
+#include <Trixy/Neuro/Network/Layer/Detail/FunctionDetail.hpp>
 
 #include <Trixy/Neuro/Checker/Detail/MacroScope.hpp>
 
@@ -23,6 +28,9 @@ public:
 private:
     Net& net;
 
+    // number of samples evaluated at once by network that supports batches
+    static constexpr size_type batch_size = 256;
+
 public:
     explicit Accuracy(Net& network) : net(network) {}
 
@@ -36,9 +44,10 @@ public:
     {
         size_type count = 0;
 
-        for (size_type i = 0; i < odata.size(); ++i)
-            if (Guide::normal(odata[i], net.feedforward(idata[i])))
-                ++count;
+        predict(idata, [&](size_type i, const auto& prediction)
+        {
+            if (Guide::normal(odata[i], prediction)) ++count;
+        }, 0);
 
         return static_cast<long double>(count) / odata.size();
     }
@@ -50,9 +59,10 @@ public:
     {
         size_type count = 0;
 
-        for (size_type i = 0; i < odata.size(); ++i)
-            if (Guide::full(odata[i], net.feedforward(idata[i]), range_rate))
-                ++count;
+        predict(idata, [&](size_type i, const auto& prediction)
+        {
+            if (Guide::full(odata[i], prediction, range_rate)) ++count;
+        }, 0);
 
         return static_cast<long double>(count) / odata.size();
     }
@@ -64,8 +74,10 @@ public:
     {
         size_type count = 0;
 
-        for (size_type i = 0; i < odata.size(); ++i)
-            count += Guide::global(odata[i], net.feedforward(idata[i]), range_rate);
+        predict(idata, [&](size_type i, const auto& prediction)
+        {
+            count += Guide::global(odata[i], prediction, range_rate);
+        }, 0);
 
         return static_cast<long double>(count) / (odata.size() * odata.front().size());
     }
@@ -76,6 +88,40 @@ public:
     {
         return normal(idata, odata);
     }
+
+private:
+    // Calls function(i, prediction) for each sample of idata,
+    // samples are passed through network by chunks if it supports batches
+    template <class Samples, class Function, class Network = Net>
+    auto predict(const Samples& idata, Function function, int) noexcept
+        -> decltype(std::declval<Network&>().feedforward_batch(std::declval<const typename Network::Matrix&>()), void())
+    {
+        using Matrix = typename Network::Matrix;
+        using VectorView = lique::VectorView<const precision_type>;
+
+        Matrix batch;
+
+        for (size_type first = 0; first < idata.size(); first += batch_size)
+        {
+            const size_type last = first + batch_size < idata.size() ? first + batch_size : idata.size();
+
+            utility::gather_batch(batch, idata, first, last);
+
+            const auto& result = net.feedforward_batch(batch);
+            const size_type width = result.shape().width;
+
+            auto row = result.data();
+            for (size_type i = first; i < last; ++i, row += width)
+                function(i, VectorView(width, row));
+        }
+    }
+
+    template <class Samples, class Function>
+    void predict(const Samples& idata, Function function, long) noexcept
+    {
+        for (size_type i = 0; i < idata.size(); ++i)
+            function(i, net.feedforward(idata[i]));
+    }
 };
 
 template <class Checkable>
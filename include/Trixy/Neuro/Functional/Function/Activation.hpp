@@ -130,13 +130,11 @@ void softmax(OutRange& result, const InRange& input) noexcept
 }
 
 template <class Range1, class Range2>
-void softmax_derived(Range1& result, const Range2& input) noexcept
+void softmax_derived(Range1& result, const Range2& /*input*/) noexcept
 {
     auto first = result.data();
     auto last  = result.data() + result.size();
 
-    auto it = input.data();
-
     while (first != last) *first++ = 1.;
 }
 
@@ -159,7 +157,7 @@ TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER(Swish, swish, swish_derived);
 TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER(ModRelu, mod_relu, mod_relu_derived);
 TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER(ModTanh, mod_tanh, mod_tanh_derived);
 
-TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER(SoftMax, softmax, softmax_derived);
+TRIXY_FUNCTION_ACTIVATION_HELPER(SoftMax, softmax, softmax_derived, false);
 
 } // namespace activation
 
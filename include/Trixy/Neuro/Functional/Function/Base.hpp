@@ -30,6 +30,12 @@ public:
 
     virtual void f(Range result, const Range input) noexcept = 0;
     virtual void df(const Range result, const Range input) noexcept = 0;
+
+    // element-wise activation may be applied to any part of range separately
+    virtual bool is_elementwise() const noexcept { return true; }
+
+    // new activation of the same type, should be deleted by caller
+    virtual IActivation* clone() const = 0;
 };
 
 } // namespace activation
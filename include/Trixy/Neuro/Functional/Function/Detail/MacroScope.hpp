@@ -38,6 +38,9 @@
     }
 
 #define TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER(name, function_name, derived_function_name)            \
+    TRIXY_FUNCTION_ACTIVATION_HELPER(name, function_name, derived_function_name, true)
+
+#define TRIXY_FUNCTION_ACTIVATION_HELPER(name, function_name, derived_function_name, elementwise)       \
     template <typename Precision = double>                                                              \
     class name : public IActivation<Precision> {                                                        \
     public:                                                                                             \
@@ -52,6 +55,10 @@
         void df(Range result, const Range input) noexcept { derived_function_name(result, input); }     \
                                                                                                         \
         void operator() (Range result, const Range input) noexcept { function_name(result, input); }    \
+                                                                                                        \
+        bool is_elementwise() const noexcept { return elementwise; }                                    \
+                                                                                                        \
+        IActivation<Precision>* clone() const { return new name; }                                      \
     }
 
 #endif // TRIXY_NEURO_FUNCTIONAL_DETAIL_MACRO_SCOPE_HPP
@@ -4,3 +4,4 @@
 #undef TRIXY_FUNCTION_GENERIC_HELPER
 #undef TRIXY_FUNCTION_GENERIC_LOSS_HELPER
 #undef TRIXY_FUNCTION_GENERIC_ACTIVATION_HELPER
+#undef TRIXY_FUNCTION_ACTIVATION_HELPER
@@ -57,6 +57,9 @@ enum class OptimizationId : std::uint8_t
     ada_grad = 5,           ///< Adaptive Gradient algorithm (stable)
     rms_prop = 6,           ///< Root Mean Square Propagation (horny)
     adam = 7,               ///< Adaptive moment estimation (quick)
+    adam8 = 8,              ///< Adam with 8-bit blockwise quantized moments (compact)
+    lars = 9,               ///< Layer-wise Adaptive Rate Scaling (large batch)
+    lamb = 10,              ///< Layer-wise Adaptive Moments for Batch training (large batch)
     size
 };
 
@@ -1,10 +1,12 @@
 #ifndef TRIXY_OPTIMIZER_ADAM_HPP
 #define TRIXY_OPTIMIZER_ADAM_HPP
 
+#include <cmath> // pow
+
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
 
-#include <Trixy/Detail/FunctionDetail.hpp>
+#include <Trixy/Lique/Lazy.hpp>
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
 #include <Trixy/Neuro/Detail/MacroScope.hpp>
@@ -32,25 +34,15 @@ public:
     using typename Base::size_type;
 
     using typename Base::Range;
-    using typename Base::RangeUnified;
-
-private:
-    using Table = OptimizerTypeSet::template Table<std::uintptr_t, RangeUnified>;
 
 private:
     Net& net;
 
-    Table buff_table_;
-    Table optimized_m_table_;
-    Table optimized_s_table_;
-
     precision_type learning_rate_;
 
     precision_type beta1, beta2;
     precision_type rbeta1, rbeta2;
 
-    precision_type tbeta1, tbeta2;
-
 public:
     Optimizer(Net& network,
               precision_type learning_rate,
@@ -58,41 +50,19 @@ public:
               precision_type beta2 = 0.999)
         : Base()
         , net(network)
-        , buff_table_()
-        , optimized_m_table_()
-        , optimized_s_table_()
         , learning_rate_(learning_rate)
         , beta1(beta1)
         , beta2(beta2)
     {
-        this->template initialize<Optimizer>();
+        this->template initialize<Optimizer>(network, 2);
 
         rbeta1 = 1. - beta1;
         rbeta2 = 1. - beta2;
-
-        tbeta1 = 1.;
-        tbeta2 = 1.;
     }
 
     Optimizer& reset() noexcept
     {
-        auto first_m = optimized_m_table_.begin();
-        auto last_m  = optimized_m_table_.end();
-
-        while (first_m != last_m)
-        {
-            first_m->fill(0.);
-            ++first_m;
-        }
-
-        auto first_s = optimized_s_table_.begin();
-        auto last_s  = optimized_m_table_.end();
-
-        while (first_s != last_s)
-        {
-            first_s->fill(0.);
-            ++first_s;
-        }
+        Base::clear();
 
         return *this;
     }
@@ -100,12 +70,13 @@ public:
     precision_type learning_rate() const noexcept { return learning_rate_; }
     void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
 
-    void update(Range param, Range grad) noexcept
+    void update(size_type slot, Range param, Range grad) noexcept
     {
-        auto& buff = this->get(buff_table_, param);
+        using lique::lazy::ref;
+        using lique::lazy::let;
 
-        auto& optimized_m = Base::get(optimized_m_table_, param);
-        auto& optimized_s = Base::get(optimized_s_table_, param);
+        auto optimized_m = Base::get(0, slot);
+        auto optimized_s = Base::get(1, slot);
 
         // m = beta1 * m + (1 - beta1) * g
         // s = beta2 * m + (1 - beta2) * g * g
@@ -115,26 +86,22 @@ public:
 
         // w = w - learning_rate * xm / sqrt(xs)
 
-        // where: t - is number of calls this function (or number of iteration in train)
-
-        tbeta1 *= beta1;
-        tbeta2 *= beta2;
+        // where: t - is number of updates of slot (or number of iteration in train)
 
-        net.linear.join(optimized_m, beta1);
-        net.linear.join(buff, rbeta1, grad);
-        net.linear.add(optimized_m, buff);
+        const auto t = static_cast<precision_type>(Base::advance(slot));
 
-        net.linear.join(optimized_s, beta2);
-        net.linear.mul(buff, grad, grad);
-        net.linear.join(buff, rbeta2);
-        net.linear.add(optimized_s, buff);
+        auto w = ref(param);
+        auto g = ref(grad);
+        auto m = ref(optimized_m);
+        auto s = ref(optimized_s);
 
-        net.linear.join(buff, 1. / (1. - tbeta2), optimized_s);
-        net.linear.apply(buff, &detail::invert_sqrt<precision_type>);
-        net.linear.mul(buff, optimized_m);
-        net.linear.join(buff,  learning_rate_ / (1. - tbeta1));
+        const precision_type step = learning_rate_ / (1. - std::pow(beta1, t));
+        const precision_type scale = 1. / (1. - std::pow(beta2, t));
+        const precision_type epsilon = 1e-9;
 
-        net.linear.sub(param, buff);
+        net.linear.fuse(let(m, beta1 * m + rbeta1 * g),
+                        let(s, beta2 * s + rbeta2 * g * g),
+                        let(w, w - step * m * rsqrt(epsilon + scale * s)));
     }
 };
 
@@ -0,0 +1,204 @@
+#ifndef TRIXY_OPTIMIZER_ADAM8_HPP
+#define TRIXY_OPTIMIZER_ADAM8_HPP
+
+#include <cstdint> // int8_t, uint8_t
+#include <cmath> // sqrt, fabs, lround, pow
+
+#include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
+#include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
+
+#include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
+
+#include <Trixy/Neuro/Detail/MacroScope.hpp>
+
+namespace trixy
+{
+
+namespace train
+{
+
+template <class Optimizeriable, class TypeSet = OptimizerTypeSet>
+using Adam8
+    = TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::adam8);
+
+// Adam with moments kept as 8-bit codes, about 2 bytes of state per parameter instead of 8 for float:
+// each block of tensor has own scale (absolute maximum of block), value is scale * (code / max_code)^2,
+// so small values keep relative precision; the second moment is stored as its square root.
+// Moments are decoded, updated and encoded again by block in one pass, no full precision copy is kept
+TRIXY_OPTIMIZER_TEMPLATE()
+class TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::adam8)
+    : public IOptimizer<Optimizeriable>
+{
+public:
+    using Net  = Optimizeriable;
+    using Base = IOptimizer<Net>;
+
+    friend Base;
+
+public:
+    using typename Base::precision_type;
+    using typename Base::size_type;
+
+    using typename Base::Range;
+
+    static constexpr size_type block = 256;
+
+private:
+    template <class T>
+    using Container = typename Net::template Container<T>;
+
+    static constexpr precision_type m_levels = 127;
+    static constexpr precision_type r_levels = 255;
+
+private:
+    precision_type learning_rate_;
+
+    precision_type beta1, beta2;
+    precision_type rbeta1, rbeta2;
+
+    Container<std::int8_t> m_codes_;    ///< first moment
+    Container<std::uint8_t> r_codes_;   ///< square root of second moment
+
+    Container<precision_type> m_scales_;
+    Container<precision_type> r_scales_;
+
+    Container<size_type> blocks_;       ///< first block of each slot of tensor
+
+public:
+    Optimizer(Net& network,
+              precision_type learning_rate,
+              precision_type beta1 = 0.9,
+              precision_type beta2 = 0.999)
+        : Base()
+        , learning_rate_(learning_rate)
+        , beta1(beta1)
+        , beta2(beta2)
+    {
+        this->template initialize<Optimizer>(network, 0);
+
+        rbeta1 = 1. - beta1;
+        rbeta2 = 1. - beta2;
+    }
+
+    Optimizer& reset() noexcept
+    {
+        for (auto& code : m_codes_) code = 0;
+        for (auto& code : r_codes_) code = 0;
+
+        for (auto& scale : m_scales_) scale = 0.;
+        for (auto& scale : r_scales_) scale = 0.;
+
+        Base::clear();
+
+        return *this;
+    }
+
+    precision_type learning_rate() const noexcept { return learning_rate_; }
+    void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
+
+    void update(size_type slot, Range param, Range grad) noexcept
+    {
+        // the same as Adam, see Adam::update
+
+        const auto t = static_cast<precision_type>(Base::advance(slot));
+
+        const precision_type step = learning_rate_ / (1. - std::pow(beta1, t));
+        const precision_type scale = 1. / (1. - std::pow(beta2, t));
+
+        Base::tensorwise(slot, param, grad, [this, step, scale](size_type k, Range w, Range g)
+        { updating(k, w.data(), g.data(), step, scale); });
+    }
+
+protected:
+    void allocate(size_type extent)
+    {
+        const size_type count = Base::slot_count();
+        const size_type slots = Base::copies() * count;
+
+        blocks_ = Container<size_type>(slots);
+
+        size_type blocks = 0;
+        for (size_type k = 0; k < slots; ++k)
+        {
+            blocks_[k] = blocks;
+            if ((k + 1) % count != 0) blocks += (Base::locate(k).size + block - 1) / block;
+        }
+
+        m_codes_ = Container<std::int8_t>(extent);
+        r_codes_ = Container<std::uint8_t>(extent);
+
+        m_scales_ = Container<precision_type>(blocks);
+        r_scales_ = Container<precision_type>(blocks);
+    }
+
+private:
+    void updating(size_type slot, precision_type* w, const precision_type* g,
+                  precision_type step, precision_type scale) noexcept
+    {
+        const auto place = Base::locate(slot);
+
+        auto m_codes = m_codes_.data() + place.offset;
+        auto r_codes = r_codes_.data() + place.offset;
+
+        const precision_type epsilon = 1e-9;
+
+        precision_type m[block];
+        precision_type r[block];
+
+        size_type k = blocks_[slot];
+        for (size_type first = 0; first < place.size; first += block, ++k)
+        {
+            const size_type size = place.size - first < block ? place.size - first : block;
+
+            const precision_type m_unit = m_scales_[k] / (m_levels * m_levels);
+            const precision_type r_unit = r_scales_[k] / (r_levels * r_levels);
+
+            precision_type m_max = 0.;
+            precision_type r_max = 0.;
+
+            for (size_type i = 0; i < size; ++i)
+            {
+                const precision_type code = m_codes[first + i];
+                const precision_type root = r_unit * r_codes[first + i] * r_codes[first + i];
+
+                const precision_type gi = g[first + i];
+                const precision_type mi = beta1 * m_unit * code * std::fabs(code) + rbeta1 * gi;
+                const precision_type si = beta2 * root * root + rbeta2 * gi * gi;
+
+                w[first + i] -= step * mi / std::sqrt(epsilon + scale * si);
+
+                m[i] = mi;
+                r[i] = std::sqrt(si);
+
+                if (std::fabs(mi) > m_max) m_max = std::fabs(mi);
+                if (r[i] > r_max) r_max = r[i];
+            }
+
+            m_scales_[k] = m_max;
+            r_scales_[k] = r_max;
+
+            const precision_type m_norm = m_max > 0. ? 1. / m_max : 0.;
+            const precision_type r_norm = r_max > 0. ? 1. / r_max : 0.;
+
+            for (size_type i = 0; i < size; ++i)
+            {
+                const precision_type code = m_levels * std::sqrt(std::fabs(m[i]) * m_norm);
+
+                m_codes[first + i] = static_cast<std::int8_t>(m[i] < 0. ? -std::lround(code) : std::lround(code));
+                r_codes[first + i] = static_cast<std::uint8_t>(std::lround(r_levels * std::sqrt(r[i] * r_norm)));
+            }
+        }
+    }
+};
+
+template <class TypeSet = OptimizerTypeSet, class Net, typename... Args>
+Adam8<Net, TypeSet> Adam8Optimizer(Net& net, Args&&... args)
+{
+    return Adam8<Net, TypeSet>(net, std::forward<Args>(args)...);
+}
+
+} // namespace train
+
+} // namespace trixy
+
+#endif // TRIXY_OPTIMIZER_ADAM8_HPP
@@ -50,6 +50,9 @@ public:
     _TRIXY_DEF_OPTIMIZER_HELPER(id_type, ada_grad)
     _TRIXY_DEF_OPTIMIZER_HELPER(id_type, rms_prop)
     _TRIXY_DEF_OPTIMIZER_HELPER(id_type, adam)
+    _TRIXY_DEF_OPTIMIZER_HELPER(id_type, adam8)
+    _TRIXY_DEF_OPTIMIZER_HELPER(id_type, lars)
+    _TRIXY_DEF_OPTIMIZER_HELPER(id_type, lamb)
 
 public:
     template <id_type id> using type_from = switch_type
@@ -61,7 +64,10 @@ public:
         nestorov::type<id>,
         ada_grad::type<id>,
         rms_prop::type<id>,
-        adam::type<id>
+        adam::type<id>,
+        adam8::type<id>,
+        lars::type<id>,
+        lamb::type<id>
     >;
 };
 
@@ -14,5 +14,9 @@
 #include <Trixy/Neuro/Functional/Optimizer/RMSProp.hpp>
 
 #include <Trixy/Neuro/Functional/Optimizer/Adam.hpp>
+#include <Trixy/Neuro/Functional/Optimizer/Adam8.hpp>
+
+#include <Trixy/Neuro/Functional/Optimizer/LARS.hpp>
+#include <Trixy/Neuro/Functional/Optimizer/LAMB.hpp>
 
 #endif // TRIXY_OPTIMIZER_CORE_HPP
@@ -1,11 +1,16 @@
 #ifndef TRIXY_OPTIMIZER_INTERFACE_HPP
 #define TRIXY_OPTIMIZER_INTERFACE_HPP
 
+#include <utility> // move
+
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 
 #include <Trixy/Range/View.hpp>
 #include <Trixy/Range/Unified.hpp>
 
+#include <Trixy/Lique/TensorBase.hpp>
+#include <Trixy/Detail/MemoryDetail.hpp>
+
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
 #include <Trixy/Detail/MacroScope.hpp>
@@ -33,15 +38,41 @@ private:
     template <typename Ret, typename... Args>
     using Func = Ret (*)(void* const, Args...);
 
+    template <class T>
+    using Container         = typename Net::template Container<T>;
+
+    using Vector            = typename Net::Vector;
+    using TensorBase        = lique::TensorBase<precision_type>;
+
+    using ITrainLayer       = typename Net::ITrainLayer;
+
+protected:
+    // place of state of one tensor of parameters in each state buffer
+    struct Slot
+    {
+        size_type offset;
+        size_type size;
+    };
+
 private:
     Func<void, precision_type> f_set_learning_rate = nullptr;
     Func<precision_type> f_get_learning_rate = nullptr;
 
-    Func<void, Range, Range> f_update = nullptr;
+    Func<void, size_type, Range, Range> f_update = nullptr;
+    Func<void, size_type> f_allocate = nullptr;
+
+    Net* net_ = nullptr;
+
+    Container<Slot> slots_;
+    size_type copies_ = 0;
+
+    Container<Vector> states_;  ///< one per kind of state, e.g. first and second moments
+    Container<size_type> steps_; ///< number of updates of each slot, see advance
 
 protected:
+    // states - number of values of state per parameter
     template <class Derived>
-    void initialize() noexcept
+    void initialize(Net& network, size_type states)
     {
         f_set_learning_rate = [](void *const self, precision_type value)
         { static_cast<Derived*>(self)->learning_rate(value); };
@@ -49,8 +80,16 @@ protected:
         f_get_learning_rate = [](void *const self) -> precision_type
         { return static_cast<Derived*>(self)->learning_rate(); };
 
-        f_update = [](void *const self, Range param, Range grad)
-        { static_cast<Derived*>(self)->update(param, grad); };
+        f_update = [](void *const self, size_type slot, Range param, Range grad)
+        { static_cast<Derived*>(self)->update(slot, param, grad); };
+
+        f_allocate = [](void *const self, size_type extent)
+        { static_cast<Derived*>(self)->allocate(extent); };
+
+        net_ = &network;
+        states_.resize(states);
+
+        bind();
     }
 
 public:
@@ -66,22 +105,123 @@ public:
         return f_get_learning_rate(this);
     }
 
-    void update(Range param, Range grad) noexcept
+    // slot - id of parameters given by bind, see ITrainLayer::bind
+    void update(size_type slot, Range param, Range grad) noexcept
+    {
+        f_update(this, slot, param, grad);
+    }
+
+    // Slots of state: k-th tensor of parameters of network (in order of ITrainLayer::parameters) has slot k,
+    // the last slot covers all of them, each tensor is placed as in the flat network, so state is contiguous;
+    // copies - number of independent sets of slots, for replicas of network with own parameters;
+    // network is bound by constructor, bind should be called again if layers of network were changed or loaded,
+    // state is kept while layout of slots is the same
+    void bind(size_type copies = 1)
     {
-        f_update(this, param, grad);
+        if (copies < copies_) copies = copies_;
+
+        Container<Slot> slots;
+        size_type offset = 0;
+
+        for (size_type copy = 0; copy < copies; ++copy)
+        {
+            const size_type first = offset;
+
+            for (size_type i = 0; i < net_->size(); ++i)
+            {
+                auto& layer = static_cast<ITrainLayer&>(net_->layer(i));
+
+                if (copy == 0) layer.bind(slots.size());
+
+                layer.parameters([&slots, &offset](TensorBase& tensor)
+                {
+                    slots.emplace_back(Slot{ offset, tensor.size() });
+                    offset += trixy::detail::padded<precision_type>(tensor.size());
+                });
+            }
+
+            slots.emplace_back(Slot{ first, offset - first });
+        }
+
+        bool is_same = slots.size() == slots_.size();
+        for (size_type k = 0; k < slots.size() and is_same; ++k)
+            is_same = slots[k].offset == slots_[k].offset and slots[k].size == slots_[k].size;
+
+        copies_ = copies;
+        slots_ = std::move(slots);
+
+        if (is_same) return;
+
+        steps_ = Container<size_type>(slots_.size());
+        for (auto& step : steps_) step = 0;
+
+        f_allocate(this, offset);
     }
 
+    size_type copies() const noexcept { return copies_; }
+
+    // number of slots of each copy, see bind
+    size_type slot_count() const noexcept { return copies_ == 0 ? 0 : slots_.size() / copies_; }
+
+    // slot of all parameters of network, see Training::flatten
+    size_type flat_slot() const noexcept { return slot_count() - 1; }
+
 protected:
-    template <class Table>
-    static RangeUnified& get(Table& table, Range range)
+    Slot locate(size_type slot) const noexcept { return slots_[slot]; }
+
+    // new zeroed state for slots of bind, extent - total size of slots,
+    // optimizer with own kind of state may replace it
+    void allocate(size_type extent)
+    {
+        for (auto& state : states_) state = Vector(extent, precision_type{});
+    }
+
+    // state of the given kind for parameters of slot
+    Range get(size_type state, size_type slot) noexcept
+    {
+        auto first = states_[state].data() + slots_[slot].offset;
+        return Range(first, first + slots_[slot].size);
+    }
+
+    void clear() noexcept
+    {
+        for (auto& state : states_) state.fill(precision_type{});
+        for (auto& step : steps_) step = 0;
+    }
+
+    // Counts update of slot and returns number of updates of it so far, e.g. for bias correction;
+    // update of slot of the whole copy is counted for each tensor of it, so flat and scattered updates
+    // give the same count, and each copy has own count
+    size_type advance(size_type slot) noexcept
+    {
+        const size_type count = slot_count();
+
+        if ((slot + 1) % count != 0) return ++steps_[slot];
+
+        const size_type first = slot + 1 - count;
+        for (size_type k = first; k < slot; ++k) ++steps_[k];
+
+        return steps_[first];
+    }
+
+    // Calls function(slot, param, grad) for slot of tensor or for each tensor of slot of the whole copy,
+    // padding between tensors is skipped; used by optimizers which treat each tensor apart
+    template <class Function>
+    void tensorwise(size_type slot, Range param, Range grad, Function&& function)
     {
-        auto key = reinterpret_cast<typename Table::key_type>(range.data());
-        auto& buff = table[key];
+        const size_type count = slot_count();
+
+        if ((slot + 1) % count != 0) return function(slot, param, grad);
 
-        if (buff.data() == nullptr)
-            buff.resize(range.size(), precision_type{});
+        const size_type first = slots_[slot].offset;
+        for (size_type k = slot + 1 - count; k < slot; ++k)
+        {
+            const size_type shift = slots_[k].offset - first;
+            const size_type last = shift + slots_[k].size;
 
-        return buff;
+            function(k, Range(param.data() + shift, param.data() + last),
+                        Range(grad.data() + shift, grad.data() + last));
+        }
     }
 };
 
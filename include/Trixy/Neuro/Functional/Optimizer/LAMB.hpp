@@ -0,0 +1,155 @@
+#ifndef TRIXY_OPTIMIZER_LAMB_HPP
+#define TRIXY_OPTIMIZER_LAMB_HPP
+
+#include <cmath> // sqrt, pow
+
+#include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
+#include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
+
+#include <Trixy/Lique/Lazy.hpp>
+
+#include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
+
+#include <Trixy/Neuro/Detail/MacroScope.hpp>
+
+namespace trixy
+{
+
+namespace train
+{
+
+template <class Optimizeriable, class TypeSet = OptimizerTypeSet>
+using LAMB
+    = TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::lamb);
+
+// Layer-wise Adaptive Moments for Batch training: Adam with step of each tensor scaled by trust ratio,
+// for training with large batches
+TRIXY_OPTIMIZER_TEMPLATE()
+class TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::lamb)
+    : public IOptimizer<Optimizeriable>
+{
+public:
+    using Net  = Optimizeriable;
+    using Base = IOptimizer<Net>;
+
+public:
+    using typename Base::precision_type;
+    using typename Base::size_type;
+
+    using typename Base::Range;
+
+private:
+    Net& net;
+
+    precision_type learning_rate_;
+    precision_type weight_decay_;
+
+    precision_type beta1, beta2;
+    precision_type rbeta1, rbeta2;
+
+public:
+    Optimizer(Net& network,
+              precision_type learning_rate,
+              precision_type weight_decay = 0.,
+              precision_type beta1 = 0.9,
+              precision_type beta2 = 0.999)
+        : Base()
+        , net(network)
+        , learning_rate_(learning_rate)
+        , weight_decay_(weight_decay)
+        , beta1(beta1)
+        , beta2(beta2)
+    {
+        this->template initialize<Optimizer>(network, 2);
+
+        rbeta1 = 1. - beta1;
+        rbeta2 = 1. - beta2;
+    }
+
+    Optimizer& reset() noexcept
+    {
+        Base::clear();
+
+        return *this;
+    }
+
+    precision_type learning_rate() const noexcept { return learning_rate_; }
+    void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
+
+    void update(size_type slot, Range param, Range grad) noexcept
+    {
+        const auto t = static_cast<precision_type>(Base::advance(slot));
+
+        const precision_type correction = 1. / (1. - std::pow(beta1, t));
+        const precision_type scale = 1. / (1. - std::pow(beta2, t));
+
+        Base::tensorwise(slot, param, grad, [this, correction, scale](size_type k, Range w, Range g)
+        { updating(k, w, g, correction, scale); });
+    }
+
+private:
+    void updating(size_type slot, Range param, Range grad,
+                  precision_type correction, precision_type scale) noexcept
+    {
+        using lique::lazy::ref;
+        using lique::lazy::let;
+
+        auto optimized_m = Base::get(0, slot);
+        auto optimized_s = Base::get(1, slot);
+
+        // m = beta1 * m + (1 - beta1) * g
+        // s = beta2 * s + (1 - beta2) * g * g
+
+        // r = xm / sqrt(xs) + weight_decay * w, where xm and xs are as in Adam
+        // w = w - learning_rate * |w| / |r| * r
+
+        const precision_type epsilon = 1e-9;
+
+        // moments are updated by the same sweep that takes both norms
+        precision_type* w = param.data();
+        const precision_type* g = grad.data();
+
+        precision_type* m = optimized_m.data();
+        precision_type* s = optimized_s.data();
+
+        precision_type w_norm = 0.;
+        precision_type r_norm = 0.;
+
+        for (size_type i = 0; i < static_cast<size_type>(param.size()); ++i)
+        {
+            m[i] = beta1 * m[i] + rbeta1 * g[i];
+            s[i] = beta2 * s[i] + rbeta2 * g[i] * g[i];
+
+            const precision_type r = correction * m[i] / std::sqrt(epsilon + scale * s[i]) + weight_decay_ * w[i];
+
+            w_norm += w[i] * w[i];
+            r_norm += r * r;
+        }
+
+        w_norm = std::sqrt(w_norm);
+        r_norm = std::sqrt(r_norm);
+
+        const precision_type ratio = w_norm > 0. and r_norm > 0. ? w_norm / r_norm : 1.;
+
+        const precision_type rate = learning_rate_ * ratio;
+        const precision_type step = rate * correction;
+
+        auto wr = ref(param);
+        auto mr = ref(optimized_m);
+        auto sr = ref(optimized_s);
+
+        net.linear.fuse(let(wr, wr - step * mr * rsqrt(epsilon + scale * sr) - rate * weight_decay_ * wr));
+    }
+};
+
+template <class TypeSet = OptimizerTypeSet, class Net, typename... Args>
+LAMB<Net, TypeSet> LAMBOptimizer(Net& net, Args&&... args)
+{
+    return LAMB<Net, TypeSet>(net, std::forward<Args>(args)...);
+}
+
+} // namespace train
+
+} // namespace trixy
+
+#endif // TRIXY_OPTIMIZER_LAMB_HPP
@@ -0,0 +1,130 @@
+#ifndef TRIXY_OPTIMIZER_LARS_HPP
+#define TRIXY_OPTIMIZER_LARS_HPP
+
+#include <cmath> // sqrt
+
+#include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
+#include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
+
+#include <Trixy/Lique/Lazy.hpp>
+
+#include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
+
+#include <Trixy/Neuro/Detail/MacroScope.hpp>
+
+namespace trixy
+{
+
+namespace train
+{
+
+template <class Optimizeriable, class TypeSet = OptimizerTypeSet>
+using LARS
+    = TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::lars);
+
+// Layer-wise Adaptive Rate Scaling: momentum with learning rate of each tensor scaled by trust ratio,
+// for training with large batches
+TRIXY_OPTIMIZER_TEMPLATE()
+class TRIXY_OPTIMIZER_TEMPLATE_CLASS(meta::is_trixy_net, OptimizerType::lars)
+    : public IOptimizer<Optimizeriable>
+{
+public:
+    using Net  = Optimizeriable;
+    using Base = IOptimizer<Net>;
+
+public:
+    using typename Base::precision_type;
+    using typename Base::size_type;
+
+    using typename Base::Range;
+
+private:
+    Net& net;
+
+    precision_type learning_rate_;
+    precision_type momentum_;
+    precision_type weight_decay_;
+    precision_type trust_;
+
+public:
+    Optimizer(Net& network,
+              precision_type learning_rate,
+              precision_type momentum = 0.9,
+              precision_type weight_decay = 0.,
+              precision_type trust = 0.001)
+        : Base()
+        , net(network)
+        , learning_rate_(learning_rate)
+        , momentum_(momentum)
+        , weight_decay_(weight_decay)
+        , trust_(trust)
+    {
+        this->template initialize<Optimizer>(network, 1);
+    }
+
+    Optimizer& reset() noexcept
+    {
+        Base::clear();
+
+        return *this;
+    }
+
+    precision_type learning_rate() const noexcept { return learning_rate_; }
+    void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
+
+    void update(size_type slot, Range param, Range grad) noexcept
+    {
+        Base::tensorwise(slot, param, grad, [this](size_type k, Range w, Range g)
+        { updating(k, w, g); });
+    }
+
+private:
+    void updating(size_type slot, Range param, Range grad) noexcept
+    {
+        using lique::lazy::ref;
+        using lique::lazy::let;
+
+        auto velocity = Base::get(0, slot);
+
+        // ratio = trust * |w| / (|g| + weight_decay * |w|)
+        // velocity = momentum * velocity + learning_rate * ratio * (g + weight_decay * w)
+        // w = w - velocity
+
+        // both norms are taken by one sweep, the update needs them before it starts
+        const precision_type* w = param.data();
+        const precision_type* g = grad.data();
+
+        precision_type w_norm = 0.;
+        precision_type g_norm = 0.;
+
+        for (size_type i = 0; i < static_cast<size_type>(param.size()); ++i)
+        {
+            w_norm += w[i] * w[i];
+            g_norm += g[i] * g[i];
+        }
+
+        w_norm = std::sqrt(w_norm);
+        g_norm = std::sqrt(g_norm);
+
+        const precision_type norm = g_norm + weight_decay_ * w_norm;
+        const precision_type ratio = w_norm > 0. and norm > 0. ? trust_ * w_norm / norm : 1.;
+
+        const precision_type rate = learning_rate_ * ratio;
+
+        net.linear.fuse(let(ref(velocity), momentum_ * ref(velocity)
+                                         + rate * (ref(grad) + weight_decay_ * ref(param))),
+                        let(ref(param), ref(param) - ref(velocity)));
+    }
+};
+
+template <class TypeSet = OptimizerTypeSet, class Net, typename... Args>
+LARS<Net, TypeSet> LARSOptimizer(Net& net, Args&&... args)
+{
+    return LARS<Net, TypeSet>(net, std::forward<Args>(args)...);
+}
+
+} // namespace train
+
+} // namespace trixy
+
+#endif // TRIXY_OPTIMIZER_LARS_HPP
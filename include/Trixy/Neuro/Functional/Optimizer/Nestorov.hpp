@@ -4,6 +4,8 @@
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
 
+#include <Trixy/Lique/Lazy.hpp>
+
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
 #include <Trixy/Neuro/Detail/MacroScope.hpp>
@@ -31,17 +33,10 @@ public:
     using typename Base::size_type;
 
     using typename Base::Range;
-    using typename Base::RangeUnified;
-
-private:
-    using Table = OptimizerTypeSet::template Table<std::uintptr_t, RangeUnified>;
 
 private:
     Net& net;
 
-    Table buff_table_;
-    Table optimized_table_;
-
     precision_type learning_rate_;
     precision_type momentum_;
 
@@ -51,24 +46,15 @@ public:
               precision_type momentum = 0.9)
         : Base()
         , net(network)
-        , buff_table_()
-        , optimized_table_()
         , learning_rate_(learning_rate)
         , momentum_(momentum)
     {
-        this->template initialize<Optimizer>();
+        this->template initialize<Optimizer>(network, 1);
     }
 
     Optimizer& reset() noexcept
     {
-        auto first = optimized_table_.begin();
-        auto last  = optimized_table_.end();
-
-        while (first != last)
-        {
-            first->fill(0.);
-            ++first;
-        }
+        Base::clear();
 
         return *this;
     }
@@ -76,21 +62,18 @@ public:
     precision_type learning_rate() const noexcept { return learning_rate_; }
     void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
 
-    void update(Range param, Range grad) noexcept
+    void update(size_type slot, Range param, Range grad) noexcept
     {
-        auto& buff = Base::get(buff_table_, param);
-        auto& optimized = Base::get(optimized_table_, param);
+        using lique::lazy::ref;
+        using lique::lazy::let;
+
+        auto velocity = Base::get(0, slot);
 
         // velocity = momentum * velocity - learning_rate * g
         // w = w + momentum * velocity - learning_rate * g
 
-        net.linear.join(optimized, momentum_);
-        net.linear.join(buff, learning_rate_, grad);
-        net.linear.sub(optimized, buff);
-
-        net.linear.sub(param, buff);
-        net.linear.join(buff, momentum_, optimized);
-        net.linear.add(param, buff);
+        net.linear.fuse(let(ref(velocity), momentum_ * ref(velocity) - learning_rate_ * ref(grad)),
+                        let(ref(param), ref(param) + momentum_ * ref(velocity) - learning_rate_ * ref(grad)));
     }
 };
 
@@ -4,7 +4,8 @@
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
 
-#include <Trixy/Detail/FunctionDetail.hpp>
+#include <Trixy/Lique/Lazy.hpp>
+
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
 #include <Trixy/Neuro/Detail/MacroScope.hpp>
@@ -32,17 +33,10 @@ public:
     using typename Base::size_type;
 
     using typename Base::Range;
-    using typename Base::RangeUnified;
-
-private:
-    using Table = OptimizerTypeSet::template Table<std::uintptr_t, RangeUnified>;
 
 private:
     Net& net;
 
-    Table buff_table_;
-    Table optimized_table_;
-
     precision_type learning_rate_;
     precision_type beta, rbeta;
 
@@ -52,26 +46,17 @@ public:
               precision_type beta = 0.9)
         : Base()
         , net(network)
-        , buff_table_()
-        , optimized_table_()
         , learning_rate_(learning_rate)
         , beta(beta)
     {
-        this->template initialize<Optimizer>();
+        this->template initialize<Optimizer>(network, 1);
 
         rbeta = 1. - beta;
     }
 
     Optimizer& reset() noexcept
     {
-        auto first = optimized_table_.begin();
-        auto last  = optimized_table_.end();
-
-        while (first != last)
-        {
-            first->fill(0.);
-            ++first;
-        }
+        Base::clear();
 
         return *this;
     }
@@ -79,24 +64,20 @@ public:
     precision_type learning_rate() const noexcept { return learning_rate_; }
     void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
 
-    void update(Range param, Range grad) noexcept
+    void update(size_type slot, Range param, Range grad) noexcept
     {
-        auto& buff = Base::get(buff_table_, param);
-        auto& optimized = Base::get(optimized_table_, param);
+        using lique::lazy::ref;
+        using lique::lazy::let;
+
+        auto velocity = Base::get(0, slot);
 
         // velocity = beta * velocity + (1 - beta) * g * g
         // w = w - learning_rate * g / sqrt(velocity)
 
-        net.linear.join(optimized, beta);
-        net.linear.mul(buff, grad, grad);
-        net.linear.join(buff, rbeta);
-        net.linear.add(optimized, buff);
-
-        net.linear.apply(buff, &detail::invert_sqrt<precision_type>, optimized);
-        net.linear.mul(buff, grad);
-        net.linear.join(buff, learning_rate_);
+        const precision_type epsilon = 1e-9;
 
-        net.linear.sub(param, buff);
+        net.linear.fuse(let(ref(velocity), beta * ref(velocity) + rbeta * ref(grad) * ref(grad)),
+                        let(ref(param), ref(param) - learning_rate_ * ref(grad) * rsqrt(epsilon + ref(velocity))));
     }
 };
 
@@ -4,6 +4,8 @@
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Interface.hpp>
 
+#include <Trixy/Lique/Lazy.hpp>
+
 #include <Trixy/Range/Unified.hpp>
 
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
@@ -49,19 +51,19 @@ public:
         , learning_rate_(learning_rate)
         , alpha_(1. - learning_rate * decay)
     {
-        this->template initialize<Optimizer>();
+        this->template initialize<Optimizer>(network, 0);
     }
 
     precision_type learning_rate() const noexcept { return learning_rate_; }
     void learning_rate(precision_type value) noexcept { learning_rate_ = value; }
 
-    void update(Range param, Range grad) noexcept
+    void update(size_type slot, Range param, Range grad) noexcept
     {
-        // w = alpha * w - learning_rate * grad
-        net.linear.join(grad, learning_rate_);
-        net.linear.join(param, alpha_);
+        using lique::lazy::ref;
+        using lique::lazy::let;
 
-        net.linear.sub(param, grad);
+        // w = alpha * w - learning_rate * grad
+        net.linear.fuse(let(ref(param), alpha_ * ref(param) - learning_rate_ * ref(grad)));
     }
 };
 
@@ -5,11 +5,17 @@
 
 #include <Trixy/Base.hpp> // LayerType, LayerMode
 
+#include <Trixy/Lique/Vector.hpp>
+#include <Trixy/Lique/Tensor.hpp>
+#include <Trixy/Lique/Strided.hpp>
+
 #include <Trixy/Serializer/Core.hpp>
 
 #include <Trixy/Neuro/Functional/Function/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 
+#include <Trixy/Neuro/Network/Layer/Detail/FunctionDetail.hpp>
+
 #include <Trixy/Detail/MacroScope.hpp>
 
 namespace trixy
@@ -42,6 +48,14 @@ public:
 
     using Linear                = typename Net::Linear;
 
+    // non-owning access to samples of batch
+    using VectorView            = lique::VectorView<precision_type>;
+    using TensorView            = lique::TensorView<precision_type>;
+    using ConstTensorView       = lique::TensorView<const precision_type>;
+    using TensorBase            = lique::TensorBase<precision_type>;
+    using StridedView           = lique::StridedView<precision_type>;
+    using ConstStridedView      = lique::StridedView<const precision_type>;
+
     using Generator             = std::function<precision_type()>; // type erasing
     using IActivation           = functional::activation::IActivation<precision_type>;
 
@@ -56,6 +70,10 @@ public:
     virtual void forward(const Tensor& input) noexcept = 0;
     virtual const Tensor& value() const noexcept = 0;
 
+    // Batch of samples is laid out contiguously, one sample per row
+    virtual void forward_batch(const Matrix& input) noexcept = 0;
+    virtual const Matrix& batch_value() const noexcept = 0;
+
     virtual const shape_type& isize() const noexcept = 0;
     virtual const shape_type& osize() const noexcept = 0;
 };
@@ -83,6 +101,13 @@ public:
 
     using typename Base::Linear;
 
+    using typename Base::VectorView;
+    using typename Base::TensorView;
+    using typename Base::ConstTensorView;
+    using typename Base::TensorBase;
+    using typename Base::StridedView;
+    using typename Base::ConstStridedView;
+
     using typename Base::Generator;
     using typename Base::IActivation;
 
@@ -95,10 +120,46 @@ public:
     virtual void backward(const Tensor& input, const Tensor& idelta, bool full = true) noexcept = 0;
     virtual const Tensor& delta() const noexcept = 0;
 
+    // Gradients of whole batch are accumulated, as by backward for each sample,
+    // input and idelta have the same layout as for forward_batch
+    virtual void backward_batch(const Matrix& input, const Matrix& idelta, bool full = true) noexcept = 0;
+    virtual const Matrix& batch_delta() const noexcept = 0;
+
     virtual void update(IOptimizer& optimizer, precision_type alpha) noexcept { /*pass*/ }
 
-    virtual void accumulate() noexcept { /*pass*/ }
+    // Gradients are accumulated by backward and backward_batch in one buffer since the last reset:
+    // reset only marks them as cleared, so the first backward after it writes instead of adding,
+    // cleared gradients are read as zeros by update, merge and gradients
     virtual void reset() noexcept { /*pass*/ }
+
+    // Data-parallel training:
+    // replica is the layer of the same type and size with own caches and gradients,
+    // its parameters are copied from layer by synchronize, its gradients are added to layer by merge
+    virtual ITrainLayer* replicate() const = 0;
+
+    virtual void synchronize(const ITrainLayer& /*layer*/) noexcept { /*pass*/ }
+    virtual void merge(const ITrainLayer& /*replica*/) noexcept { /*pass*/ }
+
+    // Local SGD: parameters are moved toward parameters of replica by alpha,
+    // so alpha = 1 / (k + 1) for k-th replica gives running mean of all of them
+    virtual void average(const ITrainLayer& /*replica*/, precision_type /*alpha*/) noexcept { /*pass*/ }
+
+    // Distributed training and flat layout of network:
+    // function(tensor) is called for each tensor of parameters or of accumulated gradients,
+    // gradients should be visited in the same order and with the same sizes as parameters
+    using Visitor = std::function<void(TensorBase&)>;
+
+    virtual void parameters(const Visitor& /*function*/) noexcept { /*pass*/ }
+    virtual void gradients(const Visitor& /*function*/) noexcept { /*pass*/ }
+
+    // Asynchronous training:
+    // replica reads and updates parameters of the given layer instead of own, nullptr restores own,
+    // optimizer state is still taken from slots of replica, see bind
+    virtual void share(ITrainLayer* /*layer*/) noexcept { /*pass*/ }
+
+    // Optimizer state: tensors of parameters have consecutive slots from the given one,
+    // in order of parameters, see IOptimizer::bind
+    virtual void bind(size_type /*slot*/) noexcept { /*pass*/ }
 };
 
 } // namespace layer
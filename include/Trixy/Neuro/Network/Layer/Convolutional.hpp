@@ -1,11 +1,16 @@
 #ifndef TRIXY_NETWORK_LAYER_CONVOLUTIONAL_HPP
 #define TRIXY_NETWORK_LAYER_CONVOLUTIONAL_HPP
 
+#include <cstddef> // size_t
+#include <algorithm> // copy
+
 #include <Trixy/Neuro/Network/Layer/Base.hpp>
 #include <Trixy/Neuro/Network/Layer/Volume.hpp>
 
 #include <Trixy/Neuro/Functional/Function/Activation.hpp>
 
+#include <Trixy/Lique/Lazy.hpp>
+
 #include <Trixy/Detail/TrixyMeta.hpp>
 
 #include <Trixy/Neuro/Network/Layer/Detail/MacroScope.hpp>
@@ -28,6 +33,9 @@ class Layer<trixy::LayerType::Convolutional, Net, LayerMode::Raw>
 {
     TRIXY_LAYER_BODY(ILayer<Net>)
 
+private:
+    using MatrixView = lique::MatrixView<precision_type>;
+
 protected:
     shape_type isize_;
     shape_type osize_;
@@ -38,7 +46,7 @@ protected:
     size_type horizontal_stride_;
 
     Vector B_;
-    Container<Tensor> Ws_;
+    Matrix W_; ///< filters, one per row, laid out as (channel, row, column)
 
 protected:
     // cache
@@ -46,6 +54,12 @@ protected:
     shape_type filter_size_;
 
     Tensor value_;
+    Matrix batch_value_;
+
+    Matrix cols_; ///< input lowered by im2col
+
+public:
+    Linear linear;
 
 public:
     Layer() {}
@@ -72,9 +86,9 @@ public:
         , horizontal_stride_(horizontal_stride)
     {
         B_.resize(filter_count).fill(0.f);
+        W_.resize(filter_count, size.depth * filter_height * filter_width).fill(0.f);
 
-        Ws_.resize(filter_count);
-        for (auto& W : Ws_) W.resize(size.depth, filter_height, filter_width).fill(0.f);
+        filter_size_ = shape_type(size.depth, filter_height, filter_width);
 
         prepare();
     }
@@ -82,15 +96,15 @@ public:
 protected:
     void prepare()
     {
-        filter_count_ = Ws_.size();
-        filter_size_ = Ws_.front().shape();
+        filter_count_ = W_.shape().height;
 
         value_.resize(osize_).fill(0.f);
+        cols_.resize(filter_size_.size, osize_.height * osize_.width).fill(0.f);
     }
 
     void init(Generator& gen) noexcept override
     {
-        for (auto& W : Ws_) W.fill(gen);
+        W_.fill(gen);
         B_.fill(gen);
     }
 
@@ -98,40 +112,46 @@ protected:
 
     void forward(const Tensor& input) noexcept override
     {
-        for (size_type f = 0; f < filter_count_; ++f)
+        convolve(input, value_);
+    }
+
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        // samples are convolved in place by views of their rows
+        auto src = input.data();
+        for (size_type n = 0; n < batch_size; ++n)
         {
-            for (size_type y = 0; y < osize_.height; ++y)
-            {
-                for (size_type x = 0; x < osize_.width; ++x)
-                {
-                    precision_type sum = B_(f);
-
-                    for (size_type i = 0; i < filter_size_.height; ++i)
-                    {
-                        for (size_type j = 0; j < filter_size_.width; ++j)
-                        {
-                            size_type i0 = vertical_stride_ * y + i - padding_;
-                            size_type j0 = horizontal_stride_ * x + j - padding_;
-
-                            // negative value will be bigger than bounds
-                            if (i0 >= isize_.height || j0 >= isize_.width)
-                                continue;
-
-                            for (size_type c = 0; c < filter_size_.depth; ++c)
-                                sum += input(c, i0, j0) * Ws_[f](c, i, j);
-                        }
-                    }
-
-                    value_(f, y, x) = sum;
-                }
-            }
+            TensorView value(osize_, batch_value_.data() + n * osize_.size);
+            convolve(ConstTensorView(isize_, src + n * isize_.size), value);
         }
     }
 
     const Tensor& value() const noexcept override { return value_; }
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
 
     const shape_type& isize() const noexcept override { return isize_; }
     const shape_type& osize() const noexcept override { return osize_; }
+
+protected:
+    template <class Input, class Value>
+    void convolve(const Input& input, Value& value) noexcept
+    {
+        // value = W . im2col(input) + B, where B is added to each row of value, viewed as matrix
+        const size_type area = osize_.height * osize_.width;
+
+        utility::im2col(input.data(), isize_, filter_size_, osize_,
+                        padding_, vertical_stride_, horizontal_stride_, cols_.data());
+
+        auto row = value.data();
+        for (size_type f = 0; f < filter_count_; ++f, row += area)
+            VectorView(area, row).fill(B_(f));
+
+        MatrixView result(filter_count_, area, value.data());
+        linear.dot(result, W_, cols_);
+    }
 };
 
 template <class Net>
@@ -140,6 +160,10 @@ class Layer<trixy::LayerType::Convolutional, Net, LayerMode::Train>
 {
     TRIXY_LAYER_BODY(ITrainLayer<Net>)
 
+private:
+    using MatrixView = lique::MatrixView<precision_type>;
+    using ConstMatrixView = lique::MatrixView<const precision_type>;
+
 protected:
     shape_type isize_;
     shape_type osize_;
@@ -150,7 +174,12 @@ protected:
     size_type horizontal_stride_;
 
     Vector B_;
-    Container<Tensor> Ws_;
+    Matrix W_; ///< filters, one per row, laid out as (channel, row, column)
+
+    Layer* shared_; // parameters are read and updated in this layer instead, if set
+    size_type slot_; // the first slot of optimizer state
+
+    bool is_clear_; // gradients are zeros since reset, but their buffers are not filled yet
 
 protected:
     // cache
@@ -159,17 +188,21 @@ protected:
 
     Tensor value_;
 
-    Container<Tensor> gradWs_;
+    Matrix gradW_;
     Vector gradB_;
 
     Tensor delta_;
-    Tensor buff_;
+
+    Matrix batch_value_;
+    Matrix batch_delta_;
+
+    Matrix cols_; ///< input lowered by im2col, then reused for delta before col2im
 
 public:
     Linear linear;
 
 public:
-    Layer() {}
+    Layer() : shared_(nullptr), slot_(0), is_clear_(false) {}
 
     Layer(const set::Input& input,
           const set::Filter& filter,
@@ -191,11 +224,14 @@ public:
         , padding_(padding)
         , vertical_stride_(vertical_stride)
         , horizontal_stride_(horizontal_stride)
+        , shared_(nullptr)
+        , slot_(0)
+        , is_clear_(false)
     {
         B_.resize(filter_count).fill(0.f);
+        W_.resize(filter_count, size.depth * filter_height * filter_width).fill(0.f);
 
-        Ws_.resize(filter_count);
-        for (auto& W : Ws_) W.resize(size.depth, filter_height, filter_width).fill(0.f);
+        filter_size_ = shape_type(size.depth, filter_height, filter_width);
 
         prepare();
     }
@@ -203,32 +239,22 @@ public:
 protected:
     void prepare()
     {
-        filter_count_ = Ws_.size();
-        filter_size_ = Ws_.front().shape();
+        filter_count_ = W_.shape().height;
 
         value_.resize(osize_).fill(0.f);
 
-        gradWs_.resize(filter_count_);
-        for (auto& gradW : gradWs_) gradW.resize(filter_size_).fill(0.f);
-
+        gradW_.resize(W_.shape()).fill(0.f);
         gradB_.resize(filter_count_).fill(0.f);
 
         delta_.resize(isize_).fill(0.f);
 
-        auto buff_size = shape_type
-        (
-            osize_.depth,
-            vertical_stride_ * (osize_.height - 1) + 1,
-            horizontal_stride_ * (osize_.width - 1) + 1
-        );
-
-        buff_.resize(buff_size).fill(0.f);
+        cols_.resize(filter_size_.size, osize_.height * osize_.width).fill(0.f);
     }
 
 public:
     void init(Generator& generation) noexcept override
     {
-        for (auto& W : Ws_) W.fill(generation);
+        W_.fill(generation);
         B_.fill(generation);
     }
 
@@ -236,118 +262,203 @@ public:
 
     void forward(const Tensor& input) noexcept override
     {
-        for (size_type f = 0; f < filter_count_; ++f)
+        convolve(input, value_);
+    }
+
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        // samples are convolved in place by views of their rows
+        auto src = input.data();
+        for (size_type n = 0; n < batch_size; ++n)
         {
-            for (size_type y = 0; y < osize_.height; ++y)
-            {
-                for (size_type x = 0; x < osize_.width; ++x)
-                {
-                    precision_type sum = B_(f);
-
-                    for (size_type i = 0; i < filter_size_.height; ++i)
-                    {
-                        for (size_type j = 0; j < filter_size_.width; ++j)
-                        {
-                            size_type i0 = vertical_stride_ * y + i - padding_;
-                            size_type j0 = horizontal_stride_ * x + j - padding_;
-
-                            // negative value will be bigger than bounds
-                            if (i0 >= isize_.height || j0 >= isize_.width)
-                                continue;
-
-                            for (size_type c = 0; c < filter_size_.depth; ++c)
-                                sum += input(c, i0, j0) * Ws_[f](c, i, j);
-                        }
-                    }
-
-                    value_(f, y, x) = sum;
-                }
-            }
+            TensorView value(osize_, batch_value_.data() + n * osize_.size);
+            convolve(ConstTensorView(isize_, src + n * isize_.size), value);
         }
     }
 
-    void backward(const Tensor& input, const Tensor& idelta, bool full = true/*unused*/) noexcept override
+    void backward(const Tensor& input, const Tensor& idelta, bool /*full*/ = true) noexcept override
     {
-        auto& size = buff_.shape();
+        backprop(input, idelta, delta_);
+    }
 
-        for (size_type d = 0; d < size.depth; d++)
-            for (size_type i = 0; i < osize_.height; ++i)
-                for (size_type j = 0; j < osize_.width; ++j)
-                    buff_(d, i * vertical_stride_, j * horizontal_stride_) = idelta(d, i, j);
+    void backward_batch(const Matrix& input, const Matrix& idelta, bool /*full*/ = true) noexcept override
+    {
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_delta_, batch_size, isize_.size);
 
-        for (size_type f = 0; f < filter_count_; ++f)
+        // gradients are accumulated over all samples of the batch
+        auto src = input.data();
+        auto isrc = idelta.data();
+        for (size_type n = 0; n < batch_size; ++n)
         {
-            for (size_type y = 0; y < size.height; ++y)
-            {
-                for (size_type x = 0; x < size.width; ++x)
-                {
-                    precision_type delta_value = buff_(f, y, x);
-
-                    for (size_type i = 0; i < filter_size_.height; ++i)
-                    {
-                        for (size_type j = 0; j < filter_size_.width; ++j)
-                        {
-                            size_type i0 = i + y - padding_;
-                            size_type j0 = j + x - padding_;
-
-                            if (i0 >= isize_.height || j0 >= isize_.width)
-                                continue;
-
-                            for (size_type c = 0; c < filter_size_.depth; ++c)
-                                gradWs_[f](c, i, j) += delta_value * input(c, i0, j0);
-                        }
-                    }
-
-                    gradB_(f) += delta_value;
-                }
-            }
+            TensorView delta(isize_, batch_delta_.data() + n * isize_.size);
+            backprop(ConstTensorView(isize_, src + n * isize_.size),
+                     ConstTensorView(osize_, isrc + n * osize_.size),
+                     delta);
         }
+    }
 
-        size_type pad_i = filter_size_.height - 1 - padding_;
-        size_type pad_j = filter_size_.width - 1 - padding_;
+    void update(IOptimizer& optimizer, precision_type alpha) noexcept override
+    {
+        zeroing();
 
-        for (size_type y = 0; y < isize_.height; ++y)
+        if (alpha != 1.f)
         {
-            for (size_type x = 0; x < isize_.width; ++x)
-            {
-                for (size_type c = 0; c < filter_size_.depth; ++c)
-                {
-                    precision_type sum = 0;
-                    for (size_type i = 0; i < filter_size_.height; ++i)
-                    {
-                        for (size_type j = 0; j < filter_size_.width; ++j)
-                        {
-                            size_type i0 = y + i - pad_i;
-                            size_type j0 = x + j - pad_j;
-
-                            if (i0 >= size.height || j0 >= size.width)
-                                continue;
-
-                            for (size_type f = 0; f < filter_count_; ++f)
-                                sum += Ws_[f](c, filter_size_.height - 1 - i, filter_size_.width - 1 - j) * buff_(f, i0, j0);
-                        }
-                    }
-
-                    delta_(c, y, x) = sum;
-                }
-            }
+            linear.join(gradW_, alpha);
+            linear.join(gradB_, alpha);
         }
+
+        auto& owner = shared_ ? *shared_ : *this;
+
+        // parameters may be shared, but state of optimizer is of own slots
+        optimizer.update(slot_, owner.W_, gradW_);
+        optimizer.update(slot_ + 1, owner.B_, gradB_);
     }
 
-    void update(IOptimizer& optimizer, precision_type alpha) noexcept override
+    // gradients are accumulated by backward itself, since the last reset
+    void reset() noexcept override { is_clear_ = true; }
+
+    Base* replicate() const override
+    {
+        return new Layer(isize_,
+                         filter_count_, filter_size_.height, filter_size_.width,
+                         padding_, vertical_stride_, horizontal_stride_);
+    }
+
+    void synchronize(const Base& layer) noexcept override
+    {
+        auto& master = static_cast<const Layer&>(layer);
+
+        W_.copy(master.W_);
+        B_.copy(master.B_);
+    }
+
+    void parameters(const typename Base::Visitor& function) noexcept override
+    {
+        function(W_);
+        function(B_);
+    }
+
+    void gradients(const typename Base::Visitor& function) noexcept override
+    {
+        zeroing();
+
+        function(gradW_);
+        function(gradB_);
+    }
+
+    void average(const Base& replica, precision_type alpha) noexcept override
     {
-        for (auto& gradW : gradWs_) linear.join(gradW, alpha);
-        linear.join(gradB_, alpha);
+        using lique::lazy::ref;
+
+        auto& shard = static_cast<const Layer&>(replica);
+
+        ref(W_) += alpha * (ref(shard.W_) - ref(W_));
+        ref(B_) += alpha * (ref(shard.B_) - ref(B_));
+    }
+
+    void share(Base* layer) noexcept override
+    {
+        shared_ = static_cast<Layer*>(layer);
+    }
+
+    void bind(size_type slot) noexcept override { slot_ = slot; }
+
+    void merge(const Base& replica) noexcept override
+    {
+        auto& shard = static_cast<const Layer&>(replica);
+
+        if (shard.is_clear_) return;
+
+        if (is_clear_)
+        {
+            gradW_.copy(shard.gradW_);
+            gradB_.copy(shard.gradB_);
 
-        for (size_type i = 0; i < Ws_.size(); ++i) optimizer.update(Ws_[i], gradWs_[i]);
-        optimizer.update(B_, gradB_);
+            is_clear_ = false;
+            return;
+        }
+
+        linear.add(gradW_, shard.gradW_);
+        linear.add(gradB_, shard.gradB_);
     }
 
     const Tensor& value() const noexcept override { return value_; }
     const Tensor& delta() const noexcept override { return delta_; }
 
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
+    const Matrix& batch_delta() const noexcept override { return batch_delta_; }
+
     const shape_type& isize() const noexcept override { return isize_; }
     const shape_type& osize() const noexcept override { return osize_; }
+
+protected:
+    const Vector& bias() const noexcept { return shared_ ? shared_->B_ : B_; }
+    const Matrix& weight() const noexcept { return shared_ ? shared_->W_ : W_; }
+
+    // cleared gradients are filled, when they are read without backward since reset
+    void zeroing() noexcept
+    {
+        if (not is_clear_) return;
+
+        gradW_.fill(0.f);
+        gradB_.fill(0.f);
+
+        is_clear_ = false;
+    }
+
+    template <class Input, class Value>
+    void convolve(const Input& input, Value& value) noexcept
+    {
+        // value = W . im2col(input) + B, where B is added to each row of value, viewed as matrix
+        const size_type area = osize_.height * osize_.width;
+
+        utility::im2col(input.data(), isize_, filter_size_, osize_,
+                        padding_, vertical_stride_, horizontal_stride_, cols_.data());
+
+        auto row = value.data();
+        for (size_type f = 0; f < filter_count_; ++f, row += area)
+            VectorView(area, row).fill(bias()(f));
+
+        MatrixView result(filter_count_, area, value.data());
+        linear.dot(result, weight(), cols_);
+    }
+
+    template <class Input, class IDelta, class Delta>
+    void backprop(const Input& input, const IDelta& idelta, Delta& delta) noexcept
+    {
+        // idelta is viewed as matrix of filter_count x area, cols = im2col(input):
+        // gradW += idelta . cols^T, gradB += sum of each row of idelta, delta = col2im(W^T . idelta),
+        // the first backward after reset overwrites gradients
+        const size_type area = osize_.height * osize_.width;
+
+        ConstMatrixView grad(filter_count_, area, idelta.data());
+
+        utility::im2col(input.data(), isize_, filter_size_, osize_,
+                        padding_, vertical_stride_, horizontal_stride_, cols_.data());
+
+        auto row = grad.data();
+        for (size_type f = 0; f < filter_count_; ++f, row += area)
+        {
+            precision_type sum = 0;
+            for (size_type k = 0; k < area; ++k) sum += row[k];
+
+            gradB_(f) = is_clear_ ? sum : gradB_(f) + sum;
+        }
+
+        linear.dot(gradW_, grad, StridedView(cols_).transpose(), not is_clear_);
+
+        is_clear_ = false;
+
+        // cols are not needed anymore and hold delta of lowered input
+        linear.dot(cols_, ConstStridedView(weight()).transpose(), grad, false);
+
+        utility::col2im(cols_.data(), isize_, filter_size_, osize_,
+                        padding_, vertical_stride_, horizontal_stride_, delta.data());
+    }
 };
 
 } // namespace layer
@@ -365,12 +476,37 @@ struct is_convolutional_layer<layer::Layer<LayerType::Convolutional, Net, LayerM
 
 CONDITIONAL_SERIALIZATION(saveload, layer, trixy::meta::is_convolutional_layer<S>::value)
 {
+    using Tensor = typename S::Tensor;
+    using Filters = typename S::template Container<Tensor>;
+
     archive & layer.isize_ & layer.osize_
             & layer.padding_
             & layer.vertical_stride_ & layer.horizontal_stride_
-            & layer.B_ & layer.Ws_;
+            & layer.B_;
 
-    if (trixy::meta::is_iarchive(archive)) layer.prepare();
+    // filters are stored one tensor per filter, as rows of W
+    Filters filters;
+
+    if (not trixy::meta::is_iarchive(archive))
+    {
+        filters.resize(layer.filter_count_);
+        for (std::size_t f = 0; f < filters.size(); ++f)
+            filters[f] = Tensor(layer.filter_size_, layer.W_.data() + f * layer.filter_size_.size);
+    }
+
+    archive & filters;
+
+    if (trixy::meta::is_iarchive(archive))
+    {
+        layer.filter_size_ = filters.front().shape();
+        layer.W_.resize(filters.size(), layer.filter_size_.size);
+
+        for (std::size_t f = 0; f < filters.size(); ++f)
+            std::copy(filters[f].data(), filters[f].data() + layer.filter_size_.size,
+                      layer.W_.data() + f * layer.filter_size_.size);
+
+        layer.prepare();
+    }
 }
 
 #endif // TRIXY_NETWORK_LAYER_CONVOLUTIONAL_HPP
@@ -1,6 +1,9 @@
 #ifndef TRIXY_NETWORK_LAYER_FUNCTION_DETAIL_HPP
 #define TRIXY_NETWORK_LAYER_FUNCTION_DETAIL_HPP
 
+#include <cstddef> // size_t
+#include <algorithm> // copy, fill
+
 #include <Trixy/Detail/TrixyMeta.hpp>
 #include <Trixy/Lique/Detail/LiqueMeta.hpp>
 
@@ -12,7 +15,149 @@ namespace trixy
 namespace utility
 {
 
-// impl here <--
+// Resizes matrix of batch only if number of samples or size of sample is changed
+template <class Matrix>
+void resize_batch(Matrix& batch, std::size_t batch_size, std::size_t sample_size)
+{
+    if (batch.shape().height != batch_size or batch.shape().width != sample_size)
+        batch.resize(batch_size, sample_size);
+}
+
+// Copies samples from range [first, last) of data to rows of batch, samples should have the same size
+template <class Matrix, class Container,
+          trixy::meta::require<not lique::meta::is_batch<Container>::value> = 0>
+void gather_batch(Matrix& batch, const Container& data, std::size_t first, std::size_t last)
+{
+    const std::size_t width = data[first].size();
+    resize_batch(batch, last - first, width);
+
+    auto row = batch.data();
+    for (std::size_t i = first; i < last; ++i, row += width)
+        std::copy(data[i].data(), data[i].data() + width, row);
+}
+
+// Samples of contiguous batch are copied at once
+template <class Matrix, class Batch, lique::meta::as_batch<Batch> = 0>
+void gather_batch(Matrix& batch, const Batch& data, std::size_t first, std::size_t last)
+{
+    const std::size_t width = data.shape().width;
+    resize_batch(batch, last - first, width);
+
+    std::copy(data.data() + first * width, data.data() + last * width, batch.data());
+}
+
+// result = F(input) for batch, F is applied to each sample separately unless it is element-wise,
+// input is a buffer of layer, ranges of its rows are passed to F as its input
+template <class Activation, class Matrix1, class Matrix2>
+void activate_batch(Activation& activation, Matrix1& result, Matrix2& input) noexcept
+{
+    using Range = typename Activation::Range;
+
+    if (activation.is_elementwise()) return activation.f(result, input);
+
+    const std::size_t width = input.shape().width;
+
+    auto dst = result.data();
+    auto src = input.data();
+
+    for (std::size_t n = 0; n < input.shape().height; ++n, dst += width, src += width)
+        activation.f(Range(dst, dst + width), Range(src, src + width));
+}
+
+// result = F'(input) for batch, F' is applied to each sample separately unless F is element-wise
+template <class Activation, class Matrix1, class Matrix2>
+void derive_batch(Activation& activation, Matrix1& result, Matrix2& input) noexcept
+{
+    using Range = typename Activation::Range;
+
+    if (activation.is_elementwise()) return activation.df(result, input);
+
+    const std::size_t width = input.shape().width;
+
+    auto dst = result.data();
+    auto src = input.data();
+
+    for (std::size_t n = 0; n < input.shape().height; ++n, dst += width, src += width)
+        activation.df(Range(dst, dst + width), Range(src, src + width));
+}
+
+// Convolution is lowered to matrix product by im2col:
+// cols((c, i, j), (y, x)) = input(c, vertical * y + i - padding, horizontal * x + j - padding),
+// zero outside of input, where (c, i, j) runs over filter and (y, x) over output, so
+// value = filters . cols for filters laid out as rows; only bounds of row are checked, not each element
+template <typename T, class Shape>
+void im2col(const T* input, const Shape& isize, const Shape& filter, const Shape& osize,
+            std::size_t padding, std::size_t vertical, std::size_t horizontal, T* cols) noexcept
+{
+    for (std::size_t c = 0; c < filter.depth; ++c)
+    {
+        const T* channel = input + c * isize.height * isize.width;
+
+        for (std::size_t i = 0; i < filter.height; ++i)
+        {
+            for (std::size_t j = 0; j < filter.width; ++j)
+            {
+                // columns that meet input: 0 <= horizontal * x + j - padding < width
+                const std::size_t x_first = padding > j ? (padding - j + horizontal - 1) / horizontal : 0;
+                const std::size_t x_bound = isize.width + padding > j
+                                          ? (isize.width + padding - j + horizontal - 1) / horizontal : 0;
+                const std::size_t x_last = x_bound < osize.width ? x_bound : osize.width;
+
+                for (std::size_t y = 0; y < osize.height; ++y, cols += osize.width)
+                {
+                    // negative value will be bigger than bounds
+                    const std::size_t i0 = vertical * y + i - padding;
+
+                    if (i0 >= isize.height or x_first >= x_last)
+                    {
+                        std::fill(cols, cols + osize.width, T(0));
+                        continue;
+                    }
+
+                    const T* row = channel + i0 * isize.width + (horizontal * x_first + j - padding);
+
+                    std::fill(cols, cols + x_first, T(0));
+                    for (std::size_t x = x_first; x < x_last; ++x, row += horizontal) cols[x] = *row;
+                    std::fill(cols + x_last, cols + osize.width, T(0));
+                }
+            }
+        }
+    }
+}
+
+// Inverse lowering of im2col: delta = sum of cols placed back to input positions, delta is overwritten
+template <typename T, class Shape>
+void col2im(const T* cols, const Shape& isize, const Shape& filter, const Shape& osize,
+            std::size_t padding, std::size_t vertical, std::size_t horizontal, T* delta) noexcept
+{
+    std::fill(delta, delta + filter.depth * isize.height * isize.width, T(0));
+
+    for (std::size_t c = 0; c < filter.depth; ++c)
+    {
+        T* channel = delta + c * isize.height * isize.width;
+
+        for (std::size_t i = 0; i < filter.height; ++i)
+        {
+            for (std::size_t j = 0; j < filter.width; ++j)
+            {
+                const std::size_t x_first = padding > j ? (padding - j + horizontal - 1) / horizontal : 0;
+                const std::size_t x_bound = isize.width + padding > j
+                                          ? (isize.width + padding - j + horizontal - 1) / horizontal : 0;
+                const std::size_t x_last = x_bound < osize.width ? x_bound : osize.width;
+
+                for (std::size_t y = 0; y < osize.height; ++y, cols += osize.width)
+                {
+                    const std::size_t i0 = vertical * y + i - padding;
+
+                    if (i0 >= isize.height or x_first >= x_last) continue;
+
+                    T* row = channel + i0 * isize.width + (horizontal * x_first + j - padding);
+                    for (std::size_t x = x_first; x < x_last; ++x, row += horizontal) *row += cols[x];
+                }
+            }
+        }
+    }
+}
 
 } // namespace utility
 
@@ -22,6 +22,12 @@
                                                                                                         \
         using typename Base::Linear;                                                                    \
                                                                                                         \
+        using typename Base::VectorView;                                                                \
+        using typename Base::TensorView;                                                                \
+        using typename Base::ConstTensorView;                                                           \
+        using typename Base::StridedView;                                                               \
+        using typename Base::ConstStridedView;                                                          \
+                                                                                                        \
         using typename Base::size_type;                                                                 \
         using typename Base::precision_type;                                                            \
         using typename Base::shape_type;                                                                \
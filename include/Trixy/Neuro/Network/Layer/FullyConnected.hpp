@@ -6,6 +6,8 @@
 
 #include <Trixy/Neuro/Functional/Function/Activation.hpp>
 
+#include <Trixy/Lique/Lazy.hpp>
+
 #include <Trixy/Detail/TrixyMeta.hpp>
 
 #include <Trixy/Neuro/Network/Layer/Detail/MacroScope.hpp>
@@ -29,6 +31,9 @@ class Layer<trixy::LayerType::FullyConnected, Net, LayerMode::Raw>
 {
     TRIXY_LAYER_BODY(ILayer<Net>)
 
+private:
+    using Range = typename IActivation::Range;
+
 protected:
     shape_type isize_;
     shape_type osize_;
@@ -41,6 +46,7 @@ protected:
 protected:
     // cache
     Tensor value_;
+    Matrix batch_value_;
 
 public:
     Linear linear;
@@ -82,17 +88,42 @@ public:
     void forward(const Tensor& input) noexcept override
     {
         // H - input
-        // S - buff
+        // value = F(H . W + B)
 
-        // S = H . W + B
-        linear.dot(value_, input, W_);
-        linear.add(value_, B_);
+        if (activation_->is_elementwise())
+        {
+            // F is applied to each block of value while it is still in cache
+            linear.dot(value_, input, W_, B_, [this](size_type first, size_type last)
+            {
+                Range block(value_.data() + first, value_.data() + last);
+                activation_->f(block, block);
+            });
+        }
+        else
+        {
+            linear.dot(value_, input, W_, B_, [](size_type, size_type) {});
+            activation_->f(value_, value_);
+        }
+    }
 
-        // value = F(S)
-        activation_->f(value_, value_);
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        // H - input, one sample per row
+        // value = F(H . W + B), where B is added to each row
+
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        auto row = batch_value_.data();
+        for (size_type n = 0; n < batch_size; ++n, row += osize_.size)
+            VectorView(osize_.size, row).copy(B_.data());
+
+        linear.dot(batch_value_, input, W_);
+        utility::activate_batch(*activation_, batch_value_, batch_value_);
     }
 
     const Tensor& value() const noexcept override { return value_; }
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
 
     const shape_type& isize() const noexcept override { return isize_; }
     const shape_type& osize() const noexcept override { return osize_; }
@@ -104,6 +135,9 @@ class Layer<trixy::LayerType::FullyConnected, Net, LayerMode::Train>
 {
     TRIXY_LAYER_BODY(ITrainLayer<Net>)
 
+private:
+    using Range = typename IActivation::Range;
+
 protected:
     shape_type isize_;
     shape_type osize_;
@@ -113,26 +147,33 @@ protected:
 
     IActivation* activation_;
 
+    Layer* shared_; // parameters are read and updated in this layer instead, if set
+    size_type slot_; // the first slot of optimizer state
+
+    bool is_clear_; // gradients are zeros since reset, but their buffers are not filled yet
+
 protected:
     // cache
     Tensor value_;
     Vector buff_;
 
     Vector gradB_;
-    Matrix gradW_;
 
     Vector gradBs_;
     Matrix gradWs_;
 
     Tensor delta_;
 
-    bool accumulated_;
+    Matrix batch_buff_;
+    Matrix batch_value_;
+    Matrix batch_grad_;
+    Matrix batch_delta_;
 
 public:
     Linear linear;
 
 public:
-    Layer() : activation_(nullptr) {}
+    Layer() : activation_(nullptr), shared_(nullptr), slot_(0), is_clear_(false) {}
 
     Layer(const set::Input& input, const set::Output& output, IActivation* activation = new Identity)
         : Layer(input.size, output.size, activation)
@@ -144,6 +185,9 @@ public:
         : Base()
         , isize_(1, 1, isize), osize_(1, 1, osize)
         , activation_(activation)
+        , shared_(nullptr)
+        , slot_(0)
+        , is_clear_(false)
     {
         B_.resize(osize).fill(0.f);
         W_.resize(isize, osize).fill(0.f);
@@ -159,9 +203,7 @@ protected:
         gradBs_.resize(osize_).fill(0.f);
         gradWs_.resize(isize_.width, osize_.width).fill(0.f);
         gradB_.resize(osize_).fill(0.f);
-        gradW_.resize(isize_.width, osize_.width).fill(0.f);
         delta_.resize(isize_).fill(0.f);
-        accumulated_ = false;
     }
 
 public:
@@ -185,71 +227,221 @@ public:
         // S - buff
 
         // S = H . W + B
-
-        linear.dot(buff_, input, W_);
-        linear.add(buff_, B_);
-
         // value = F(S)
-        activation_->f(value_, buff_);
+
+        if (activation_->is_elementwise())
+        {
+            // S is kept for backward, F is applied to each block of it while it is still in cache
+            linear.dot(buff_, input, weight(), bias(), [this](size_type first, size_type last)
+            {
+                activation_->f(Range(value_.data() + first, value_.data() + last),
+                               Range(buff_.data() + first, buff_.data() + last));
+            });
+        }
+        else
+        {
+            linear.dot(buff_, input, weight(), bias(), [](size_type, size_type) {});
+            activation_->f(value_, buff_);
+        }
     }
 
     void backward(const Tensor& input, const Tensor& idelta, bool full = true) noexcept override
     {
+        using lique::lazy::ref;
+        using lique::lazy::let;
+
         // curr_delta  - gradB
         // input_delta - idelta
         // S - buff
         // curr_delta = input_delta * F'(S)
+        // gradBs += curr_delta, by the same pass
 
         activation_->df(gradB_, buff_);
-        linear.mul(gradB_, idelta);
 
-        // H - input
-        // gradB - delta
-        // gradW = H . delta, where . - tensordot
-        linear.tensordot(gradW_, input, gradB_);
+        if (is_clear_) linear.fuse(let(ref(gradB_), ref(gradB_) * ref(idelta)), let(ref(gradBs_), ref(gradB_)));
+        else linear.fuse(let(ref(gradB_), ref(gradB_) * ref(idelta)), let(ref(gradBs_), ref(gradBs_) + ref(gradB_)));
 
-        // curr_delta - gradB
+        // H - input
+        // gradWs += H . curr_delta, where . - tensordot
         // delta = curr_delta . W^T
+        // both of them are computed by single pass over rows of W and gradWs
+
+        if (full)
+        {
+            if (is_clear_) linear.dot_tensordot(delta_, gradWs_, weight(), input, gradB_);
+            else linear.dot_tensordot_add(delta_, gradWs_, weight(), input, gradB_);
+        }
+        else
+        {
+            if (is_clear_) linear.tensordot(gradWs_, input, gradB_);
+            else linear.tensordot_add(gradWs_, input, gradB_);
+        }
 
-        if (full) linear.dot(delta_, W_, gradB_);
+        is_clear_ = false;
     }
 
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        // H - input, one sample per row
+        // S - batch_buff
+
+        // S = H . W + B, where B is added to each row
+        // value = F(S)
+
+        const size_type batch_size = input.shape().height;
+
+        utility::resize_batch(batch_buff_, batch_size, osize_.size);
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        auto row = batch_buff_.data();
+        for (size_type n = 0; n < batch_size; ++n, row += osize_.size)
+            VectorView(osize_.size, row).copy(bias().data());
+
+        linear.dot(batch_buff_, input, weight());
+        utility::activate_batch(*activation_, batch_value_, batch_buff_);
+    }
+
+    void backward_batch(const Matrix& input, const Matrix& idelta, bool full = true) noexcept override
+    {
+        // G - batch_grad, one sample per row
+        // G = idelta * F'(S)
+
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_grad_, batch_size, osize_.size);
+
+        utility::derive_batch(*activation_, batch_grad_, batch_buff_);
+        linear.mul(batch_grad_, idelta);
+
+        if (batch_size > 0)
+        {
+            // gradBs += sum of rows of G
+            auto row = batch_grad_.data();
+            for (size_type n = 0; n < batch_size; ++n, row += osize_.size)
+            {
+                if (n == 0 and is_clear_) gradBs_.copy(row);
+                else linear.add(gradBs_, VectorView(osize_.size, row));
+            }
+
+            // gradWs += H^T . G
+            linear.dot(gradWs_, ConstStridedView(input).transpose(), batch_grad_, not is_clear_);
+
+            is_clear_ = false;
+        }
+
+        if (not full) return;
+
+        // delta = G . W^T
+        utility::resize_batch(batch_delta_, batch_size, isize_.size);
+
+        linear.dot(batch_delta_, batch_grad_, ConstStridedView(weight()).transpose(), false);
+    }
+
+    // gradients are accumulated by backward itself, since the last reset
     void update(IOptimizer& optimizer, precision_type alpha) noexcept override
     {
-        auto& gradB = accumulated_ ? gradBs_ : gradB_;
-        auto& gradW = accumulated_ ? gradWs_ : gradW_;
+        zeroing();
 
         if (alpha != 1.f)
         {
-            linear.join(gradB, alpha);
-            linear.join(gradW, alpha);
+            linear.join(gradBs_, alpha);
+            linear.join(gradWs_, alpha);
         }
 
-        optimizer.update(B_, gradB);
-        optimizer.update(W_, gradW);
+        auto& owner = shared_ ? *shared_ : *this;
+
+        // parameters may be shared, but state of optimizer is of own slots
+        optimizer.update(slot_, owner.B_, gradBs_);
+        optimizer.update(slot_ + 1, owner.W_, gradWs_);
     }
 
-    void reset() noexcept override
+    void reset() noexcept override { is_clear_ = true; }
+
+    Base* replicate() const override
     {
-        gradBs_.fill(0.f);
-        gradWs_.fill(0.f);
+        return new Layer(isize_.size, osize_.size, activation_->clone());
+    }
 
-        accumulated_ = false;
+    void synchronize(const Base& layer) noexcept override
+    {
+        auto& master = static_cast<const Layer&>(layer);
+
+        B_.copy(master.B_);
+        W_.copy(master.W_);
+    }
+
+    void parameters(const typename Base::Visitor& function) noexcept override
+    {
+        function(B_);
+        function(W_);
     }
 
-    void accumulate() noexcept override
+    void gradients(const typename Base::Visitor& function) noexcept override
     {
-        linear.add(gradBs_, gradB_);
-        linear.add(gradWs_, gradW_);
+        zeroing();
 
-        accumulated_ = true;
+        function(gradBs_);
+        function(gradWs_);
+    }
+
+    void average(const Base& replica, precision_type alpha) noexcept override
+    {
+        using lique::lazy::ref;
+
+        auto& shard = static_cast<const Layer&>(replica);
+
+        ref(B_) += alpha * (ref(shard.B_) - ref(B_));
+        ref(W_) += alpha * (ref(shard.W_) - ref(W_));
+    }
+
+    void share(Base* layer) noexcept override
+    {
+        shared_ = static_cast<Layer*>(layer);
+    }
+
+    void bind(size_type slot) noexcept override { slot_ = slot; }
+
+    void merge(const Base& replica) noexcept override
+    {
+        auto& shard = static_cast<const Layer&>(replica);
+
+        if (shard.is_clear_) return;
+
+        if (is_clear_)
+        {
+            gradBs_.copy(shard.gradBs_);
+            gradWs_.copy(shard.gradWs_);
+
+            is_clear_ = false;
+            return;
+        }
+
+        linear.add(gradBs_, shard.gradBs_);
+        linear.add(gradWs_, shard.gradWs_);
     }
 
     const Tensor& value() const noexcept override { return value_; }
     const Tensor& delta() const noexcept override { return delta_; }
 
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
+    const Matrix& batch_delta() const noexcept override { return batch_delta_; }
+
     const shape_type& isize() const noexcept override { return isize_; }
     const shape_type& osize() const noexcept override { return osize_; }
+
+protected:
+    const Vector& bias() const noexcept { return shared_ ? shared_->B_ : B_; }
+    const Matrix& weight() const noexcept { return shared_ ? shared_->W_ : W_; }
+
+    // cleared gradients are filled, when they are read without backward since reset
+    void zeroing() noexcept
+    {
+        if (not is_clear_) return;
+
+        gradBs_.fill(0.f);
+        gradWs_.fill(0.f);
+
+        is_clear_ = false;
+    }
 };
 
 } // namespace layer
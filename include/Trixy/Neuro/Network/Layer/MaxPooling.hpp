@@ -43,6 +43,7 @@ protected:
 protected:
     // cache
     Tensor value_;
+    Matrix batch_value_;
 
 public:
     Linear linear;
@@ -90,6 +91,36 @@ public:
     }
 
     void forward(const Tensor& input) noexcept override
+    {
+        pool(input, value_);
+        activation_->f(value_, value_);
+    }
+
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        const size_type batch_size = input.shape().height;
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        // samples are pooled in place by views of their rows
+        auto src = input.data();
+        for (size_type n = 0; n < batch_size; ++n)
+        {
+            TensorView value(osize_, batch_value_.data() + n * osize_.size);
+            pool(ConstTensorView(isize_, src + n * isize_.size), value);
+        }
+
+        utility::activate_batch(*activation_, batch_value_, batch_value_);
+    }
+
+    const Tensor& value() const noexcept override { return value_; }
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
+
+    const shape_type& isize() const noexcept override { return isize_; }
+    const shape_type& osize() const noexcept override { return osize_; }
+
+protected:
+    template <class Input, class Value>
+    void pool(const Input& input, Value& value) const noexcept
     {
         for (size_type d = 0; d < isize_.depth; ++d)
         {
@@ -108,18 +139,11 @@ public:
                         }
                     }
 
-                    value_(d, i / vertical_stride_, j / horizontal_stride_) = max;
+                    value(d, i / vertical_stride_, j / horizontal_stride_) = max;
                 }
             }
         }
-
-        activation_->f(value_, value_);
     }
-
-    const Tensor& value() const noexcept override { return value_; }
-
-    const shape_type& isize() const noexcept override { return isize_; }
-    const shape_type& osize() const noexcept override { return osize_; }
 };
 
 template <class Net>
@@ -146,6 +170,11 @@ protected:
 
     Tensor delta_;
 
+    Matrix batch_buff_;
+    Matrix batch_mask_;
+    Matrix batch_value_;
+    Matrix batch_delta_;
+
 public:
     Linear linear;
 
@@ -200,7 +229,80 @@ public:
 
     void forward(const Tensor& input) noexcept override
     {
-        mask_.fill(0.f);
+        // buff - max of each window, before activation
+        pool(input, buff_, mask_);
+        activation_->f(value_, buff_);
+    }
+
+    void backward(const Tensor& /*input*/, const Tensor& idelta, bool /*full*/ = true) noexcept override
+    {
+        activation_->df(buff_, buff_);
+        linear.mul(buff_, idelta);
+
+        unpool(buff_, mask_, delta_);
+    }
+
+    void forward_batch(const Matrix& input) noexcept override
+    {
+        const size_type batch_size = input.shape().height;
+
+        utility::resize_batch(batch_buff_, batch_size, osize_.size);
+        utility::resize_batch(batch_mask_, batch_size, isize_.size);
+        utility::resize_batch(batch_value_, batch_size, osize_.size);
+
+        // samples are pooled in place by views of their rows
+        auto src = input.data();
+        for (size_type n = 0; n < batch_size; ++n)
+        {
+            TensorView buff(osize_, batch_buff_.data() + n * osize_.size);
+            TensorView mask(isize_, batch_mask_.data() + n * isize_.size);
+
+            pool(ConstTensorView(isize_, src + n * isize_.size), buff, mask);
+        }
+
+        utility::activate_batch(*activation_, batch_value_, batch_buff_);
+    }
+
+    void backward_batch(const Matrix& /*input*/, const Matrix& idelta, bool /*full*/ = true) noexcept override
+    {
+        const size_type batch_size = idelta.shape().height;
+        utility::resize_batch(batch_delta_, batch_size, isize_.size);
+
+        utility::derive_batch(*activation_, batch_buff_, batch_buff_);
+        linear.mul(batch_buff_, idelta);
+
+        for (size_type n = 0; n < batch_size; ++n)
+        {
+            TensorView buff(osize_, batch_buff_.data() + n * osize_.size);
+            TensorView mask(isize_, batch_mask_.data() + n * isize_.size);
+            TensorView delta(isize_, batch_delta_.data() + n * isize_.size);
+
+            unpool(buff, mask, delta);
+        }
+    }
+
+    Base* replicate() const override
+    {
+        return new Layer(isize_.depth, isize_.height, isize_.width,
+                         vertical_stride_, horizontal_stride_,
+                         activation_->clone());
+    }
+
+    const Tensor& value() const noexcept override { return value_; }
+    const Tensor& delta() const noexcept override { return delta_; }
+
+    const Matrix& batch_value() const noexcept override { return batch_value_; }
+    const Matrix& batch_delta() const noexcept override { return batch_delta_; }
+
+    const shape_type& isize() const noexcept override { return isize_; }
+    const shape_type& osize() const noexcept override { return osize_; }
+
+protected:
+    // writes max of each window to buff and marks its position in mask
+    template <class Input, class Buff, class Mask>
+    void pool(const Input& input, Buff& buff, Mask& mask) const noexcept
+    {
+        mask.fill(0.f);
 
         for (size_type d = 0; d < isize_.depth; ++d)
         {
@@ -218,7 +320,6 @@ public:
                         for (size_type x = j; x < j + horizontal_stride_; ++x)
                         {
                             precision_type value = input(d, y, x);
-                            mask_(d, y, x) = 0.f;
 
                             if (value > max)
                             {
@@ -229,31 +330,22 @@ public:
                         }
                     }
 
-                    value_(d, i / vertical_stride_, j / horizontal_stride_) = max;
-                    mask_(d, imax, jmax) = 1.f;
+                    buff(d, i / vertical_stride_, j / horizontal_stride_) = max;
+                    mask(d, imax, jmax) = 1.f;
                 }
             }
         }
-
-        activation_->f(value_, buff_);
     }
 
-    void backward(const Tensor& /*input*/, const Tensor& idelta, bool full = true/*unused*/) noexcept override
+    // spreads gradient of each window to position of its max
+    template <class Buff, class Mask, class Delta>
+    void unpool(const Buff& buff, const Mask& mask, Delta& delta) const noexcept
     {
-        activation_->df(buff_, buff_);
-        linear.mul(buff_, idelta);
-
         for (size_type d = 0; d < isize_.depth; ++d)
             for (size_type i = 0; i < isize_.height; ++i)
                 for (size_type j = 0; j < isize_.width; ++j)
-                    delta_(d, i, j) = buff_(d, i / vertical_stride_, j / horizontal_stride_) * mask_(d, i, j);
+                    delta(d, i, j) = buff(d, i / vertical_stride_, j / horizontal_stride_) * mask(d, i, j);
     }
-
-    const Tensor& value() const noexcept override { return value_; }
-    const Tensor& delta() const noexcept override { return delta_; }
-
-    const shape_type& isize() const noexcept override { return isize_; }
-    const shape_type& osize() const noexcept override { return osize_; }
 };
 
 } // namespace layer
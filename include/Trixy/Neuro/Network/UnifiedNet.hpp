@@ -32,6 +32,7 @@ public:
     using Vector                    = typename TypeSet::Vector;
     using Matrix                    = typename TypeSet::Matrix;
     using Tensor                    = typename TypeSet::Tensor;
+    using Batch                     = typename TypeSet::Batch;
 
     template <typename T>
     using XContainer                = memory::ContainerLocker<Container<T>>;
@@ -72,6 +73,9 @@ public:
     const Tensor& feedforward(const Tensor& sample) noexcept;
     const Tensor& operator() (const Tensor& sample) noexcept;
 
+    // batch - one sample per row, result has one prediction per row
+    const Matrix& feedforward_batch(const Matrix& batch) noexcept;
+
     template <class FloatGenerator>
     void init(FloatGenerator generator) noexcept;
 };
@@ -135,6 +139,18 @@ auto TrixyNet<TypeSet>::operator() (
     return feedforward(sample);
 }
 
+TRIXY_NET_TEMPLATE()
+auto TrixyNet<TypeSet>::feedforward_batch(
+    const Matrix& batch) noexcept -> const Matrix&
+{
+    layer(0).forward_batch(batch);
+
+    for (size_type i = 1; i < inner_.size(); ++i)
+        layer(i).forward_batch(layer(i - 1).batch_value());
+
+    return layer(inner_.size() - 1).batch_value();
+}
+
 TRIXY_NET_TEMPLATE()
 template <class TopologyGenerator>
 void TrixyNet<TypeSet>::init(
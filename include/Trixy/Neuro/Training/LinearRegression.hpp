@@ -4,6 +4,8 @@
 #include <Trixy/Neuro/Training/Base.hpp>
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
+#include <Trixy/Lique/Strided.hpp>
+
 #include <Trixy/Neuro/Detail/MacroScope.hpp>
 
 namespace trixy
@@ -53,8 +55,11 @@ void LinearRegressionTraining<Trainable>::train(
             X(i, j) = idata(i, j - 1);
     }
 
-    Matrix X_T = reg.linear.transpose(X);
-    Matrix X_T_X = reg.linear.dot(X_T, X);
+    // transposed view of X, that is read by gemm in place
+    const auto X_T = lique::StridedView<precision_type>(X).transpose();
+
+    Matrix X_T_X(reg.N, reg.N, 0.);
+    reg.linear.dot(X_T_X, X_T, X);
 
     // W = (X^T . X)^(-1) . X^T . Y
     reg.linear.dot(
@@ -1,11 +1,24 @@
 #ifndef TRIXY_TRAINING_UNIFIED_NET_HPP
 #define TRIXY_TRAINING_UNIFIED_NET_HPP
 
+#include <algorithm> // fill, copy
+#include <initializer_list> // initializer_list
+#include <thread> // yield
+
 #include <Trixy/Neuro/Training/Base.hpp>
 
 #include <Trixy/Neuro/Functional/Function/Base.hpp>
 #include <Trixy/Neuro/Functional/Optimizer/Base.hpp>
 
+#include <Trixy/Neuro/Network/Layer/Detail/FunctionDetail.hpp>
+
+#include <Trixy/Lique/TensorBase.hpp>
+#include <Trixy/Detail/MemoryDetail.hpp>
+
+#include <Trixy/Thread/Core.hpp>
+#include <Trixy/Distributed/Base.hpp>
+#include <Trixy/Distributed/Reducer.hpp>
+
 #include <Trixy/Neuro/Detail/TrixyNetMeta.hpp>
 
 #include <Trixy/Neuro/Detail/MacroScope.hpp>
@@ -32,6 +45,7 @@ public:
     using Vector                    = typename Net::Vector;
     using Matrix                    = typename Net::Matrix;
     using Tensor                    = typename Net::Tensor;
+    using Batch                     = typename Net::Batch;
 
     template <class T>
     using XContainer                = typename Net::template XContainer<T>;
@@ -44,24 +58,56 @@ public:
     using size_type                 = typename Net::size_type;
 
     using ITrainLayer               = typename Net::ITrainLayer;
+    using TensorBase                = lique::TensorBase<precision_type>;
 
     using ILoss                     = functional::loss::ILoss<precision_type>;
     using IOptimizer                = train::IOptimizer<Net>;
 
+    using ICommunicator             = distributed::ICommunicator;
+    using ICompressor               = distributed::ICompressor<precision_type>;
+    using Reducer                   = distributed::Reducer<precision_type>;
+
+private:
+    // Worker's copy of network layers with own caches and gradient shards,
+    // the first worker uses layers of network itself
+    struct Replica
+    {
+        Container<ITrainLayer*> inner;
+
+        Tensor delta;
+
+        Matrix batch_sample;
+        Matrix batch_target;
+        Matrix batch_delta;
+    };
+
 private:
     Net& net;                       ///< reference to network prevent her copying
 
     Tensor delta;                   ///< back propogation delta tensor
 
+    Matrix batch_sample;            ///< mini-batch samples, one per row
+    Matrix batch_target;            ///< mini-batch targets, one per row
+    Matrix batch_delta;             ///< back propogation delta of mini-batch, one per row
+
     ILoss* loss_;
 
+    utility::ThreadPool pool_;      ///< workers of data-parallel mini-batch and of asynchronous stochastic
+    Container<Replica> replicas_;   ///< one per worker
+
+    ICommunicator* communicator_;   ///< not owned, processes of distributed mini-batch
+    Reducer* reducer_;              ///< sums gradients of all processes during backprop
+
+    Vector flat_parameters_;        ///< parameters of all layers, while network is flat
+    Vector flat_gradients_;         ///< accumulated gradients of all layers, in the same layout
+
 public:
     explicit Training(Net& network);
     ~Training();
 
-    // operator= for copy and move Training object will not implicit generate
-    Training(const Training&) = default;
-    Training(Training&&) noexcept = default;
+    // owns loss, reducer and replicas of layers
+    Training(const Training&) = delete;
+    Training& operator= (const Training&) = delete;
 
     template <class GeneratorInteger>
     void stochastic(const Container<Tensor>& idata,
@@ -81,11 +127,61 @@ public:
                     size_type number_of_epochs,
                     size_type mini_batch_size) noexcept;
 
+    // contiguous dataset, mini-batches are copied from it at once
+    void mini_batch(const Batch& idata,
+                    const Batch& odata,
+                    IOptimizer& optimizer,
+                    size_type number_of_epochs,
+                    size_type mini_batch_size) noexcept;
+
+    // Local SGD: dataset is split between all threads of pool, each of them trains own replica
+    // by mini-batches of its shard and all replicas are averaged every averaging_period iterations
+    void local_mini_batch(const Container<Tensor>& idata,
+                          const Container<Tensor>& odata,
+                          IOptimizer& optimizer,
+                          size_type number_of_epochs,
+                          size_type mini_batch_size,
+                          size_type averaging_period) noexcept;
+
+    void local_mini_batch(const Batch& idata,
+                          const Batch& odata,
+                          IOptimizer& optimizer,
+                          size_type number_of_epochs,
+                          size_type mini_batch_size,
+                          size_type averaging_period) noexcept;
+
+    // Asynchronous parameter server, see distributed::ParameterChannel:
+    // server applies gradients pushed by workers until number_of_updates is reached,
+    // gradients computed from parameters that are older than max_staleness updates are dropped
+    template <class Channel>
+    void parameter_server(Channel& channel,
+                          IOptimizer& optimizer,
+                          size_type number_of_updates,
+                          size_type max_staleness) noexcept;
+
+    // worker pulls parameters, pushes gradients of random mini-batch, until server stops
+    template <class Channel, class GeneratorInteger>
+    void parameter_worker(Channel& channel,
+                          size_type worker,
+                          const Container<Tensor>& idata,
+                          const Container<Tensor>& odata,
+                          size_type mini_batch_size,
+                          GeneratorInteger generator) noexcept;
+
+    // size of channel for parameter server
+    size_type parameter_count() noexcept;
+
     void feedforward(const Tensor& sample) noexcept;
 
     void backprop(const Tensor& sample,
                   const Tensor& target) noexcept;
 
+    // batch and target - one sample per row
+    void feedforward_batch(const Matrix& batch) noexcept;
+
+    void backprop_batch(const Matrix& batch,
+                        const Matrix& target) noexcept;
+
     void loss(ILoss* loss);
 
     bool update();
@@ -93,6 +189,35 @@ public:
     long double loss(const Container<Tensor>& idata,
                      const Container<Tensor>& odata) const noexcept;
 
+    // Each mini-batch is split between all processes of communicator (it takes precedence over pool),
+    // all of them should call the same training methods, parameters of rank 0 are used as initial ones;
+    // nullptr restores single process training;
+    // gradients are exchanged in compressed form if compressor is set, it is not owned
+    void communicator(ICommunicator* communicator, ICompressor* compressor = nullptr);
+
+    // nullptr if training is not distributed
+    const Reducer* reducer() const noexcept { return reducer_; }
+
+    // Flat layout: parameters of all layers, and separately their accumulated gradients,
+    // are moved to single aligned buffers and layers keep views into them,
+    // so optimizer updates the whole network by one sweep;
+    // network should not be resized or loaded while it is flat, unflatten restores own buffers of layers,
+    // it is called by destructor, so training should be destroyed before network
+    void flatten();
+    void unflatten();
+
+    bool is_flat() const noexcept { return flat_parameters_.data() != nullptr; }
+
+    // element of gradients corresponds to element of parameters with the same index,
+    // padding between tensors of layers is zero
+    Vector& flat_parameters() noexcept { return flat_parameters_; }
+    Vector& flat_gradients() noexcept { return flat_gradients_; }
+
+    // Each mini-batch is split between all threads of pool, single thread by default,
+    // stochastic runs lock-free on all threads of pool, updating shared parameters without synchronization,
+    // each thread with own copy of optimizer state
+    utility::ThreadPool& pool() noexcept { return pool_; }
+
 private:
     ITrainLayer& layer(size_type i) noexcept;
 
@@ -101,18 +226,110 @@ private:
     void updating(IOptimizer& optimizer, precision_type alpha) noexcept;
 
     void reseting() noexcept;
-    void accumulating() noexcept;
+
+    template <class Samples, class Targets>
+    void mini_batching(const Samples& idata,
+                       const Targets& odata,
+                       size_type sample_count,
+                       IOptimizer& optimizer,
+                       size_type number_of_epochs,
+                       size_type mini_batch_size) noexcept;
+
+    template <class Samples, class Targets>
+    void local_mini_batching(const Samples& idata,
+                             const Targets& odata,
+                             size_type sample_count,
+                             IOptimizer& optimizer,
+                             size_type number_of_epochs,
+                             size_type mini_batch_size,
+                             size_type averaging_period) noexcept;
+
+    template <class Layer>
+    void backpropagating(Layer layer,
+                         const Tensor& sample,
+                         const Tensor& target,
+                         Tensor& delta) noexcept;
+
+    template <class Layer>
+    void backpropagating(Layer layer,
+                         const Matrix& batch,
+                         const Matrix& target,
+                         Matrix& delta) noexcept;
+
+    template <class Layer, class Callback>
+    void backpropagating(Layer layer,
+                         const Matrix& batch,
+                         const Matrix& target,
+                         Matrix& delta,
+                         Callback callback) noexcept;
+
+    template <class Samples, class Targets>
+    void sharding(size_type worker,
+                  const Samples& idata,
+                  const Targets& odata,
+                  size_type first,
+                  size_type last) noexcept;
+
+    void hogwilding(size_type worker,
+                    const Container<Tensor>& idata,
+                    const Container<Tensor>& odata,
+                    const Container<size_type>& samples,
+                    size_type first,
+                    size_type last,
+                    IOptimizer& optimizer) noexcept;
+
+    template <class Samples, class Targets>
+    void localing(size_type worker,
+                  const Samples& idata,
+                  const Targets& odata,
+                  size_type first,
+                  size_type last,
+                  size_type mini_batch_size,
+                  IOptimizer& optimizer) noexcept;
+
+    void averaging() noexcept;
+
+    template <class Samples, class Targets>
+    void distributing(const Samples& idata,
+                      const Targets& odata,
+                      size_type first,
+                      size_type last) noexcept;
+
+    void broadcasting() noexcept;
+
+    // function(tensor) for each tensor of parameters (or of gradients) of network
+    template <class Function>
+    void visiting(bool is_gradient, Function function) noexcept;
+
+    // function(data, size, offset) for each buffer of parameters (or of gradients) of network,
+    // offset - in the flat concatenation of all of them, returns total size
+    template <class Function>
+    size_type flattening(bool is_gradient, Function function) noexcept;
+
+    // moves tensors of network to the returned buffer, each of them is aligned
+    Vector arranging(bool is_gradient);
+
+    void replicating();
+    void releasing() noexcept;
+
+    // replicas read and update parameters of network instead of own ones, or own ones again
+    void sharing(bool is_shared) noexcept;
 };
 
 TRIXY_TRAINING_TEMPLATE()
 UnifiedNetTraining<Trainable>::Training(Trainable& network)
-    : net(network), delta(network.inner().back()->osize()), loss_(nullptr)
+    : net(network), delta(network.inner().back()->osize()), loss_(nullptr), pool_(1)
+    , communicator_(nullptr), reducer_(nullptr)
 {
 }
 
 TRIXY_TRAINING_TEMPLATE()
 UnifiedNetTraining<Trainable>::~Training()
 {
+    unflatten();
+    releasing();
+
+    delete reducer_;
     delete loss_;
 }
 
@@ -123,6 +340,15 @@ void UnifiedNetTraining<Trainable>::loss(ILoss* loss)
     loss_ = loss;
 }
 
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::communicator(ICommunicator* communicator, ICompressor* compressor)
+{
+    delete reducer_;
+
+    communicator_ = communicator;
+    reducer_ = communicator == nullptr ? nullptr : new Reducer(*communicator, compressor);
+}
+
 TRIXY_TRAINING_TEMPLATE()
 bool UnifiedNetTraining<Trainable>::update()
 {
@@ -145,16 +371,57 @@ void UnifiedNetTraining<Trainable>::stochastic(
     size_type iteration_scale,
     GeneratorInteger generator) noexcept
 {
-    for (size_type iteration = 0, sample; iteration < iteration_scale; ++iteration)
+    const size_type workers = pool_.size();
+
+    if (workers == 1)
     {
-        sample = generator() % idata.size();
+        for (size_type iteration = 0, sample; iteration < iteration_scale; ++iteration)
+        {
+            sample = generator() % idata.size();
+
+            // layers may accumulate gradients during backprop
+            reseting();
 
-        feedforward(idata[sample]);
-        backprop(idata[sample], odata[sample]);
+            feedforward(idata[sample]);
+            backprop(idata[sample], odata[sample]);
 
-        // Updating the model with dynamic gradients, without their accumulation
-        updating(optimizer, 1.f);
+            // Updating the model with dynamic gradients, without their accumulation
+            updating(optimizer, 1.f);
+        }
+
+        return;
     }
+
+    // Hogwild: generator is not thread safe, so all samples are drawn in advance
+    Container<size_type> samples(iteration_scale);
+    for (auto& sample : samples) sample = generator() % idata.size();
+
+    replicating();
+
+    // only parameters of network are shared, each worker has own copy of optimizer state,
+    // step counts and quantized blocks included, as replicas of local SGD have
+    optimizer.bind(workers);
+
+    for (size_type k = 1; k < workers; ++k)
+        for (size_type i = 0, slot = k * optimizer.slot_count(); i < net.size(); ++i)
+        {
+            replicas_[k].inner[i]->bind(slot);
+            layer(i).parameters([&slot](TensorBase&) { ++slot; });
+        }
+
+    sharing(true);
+
+    // workers read and update parameters of network concurrently, without any locks
+    pool_.parallel_for(workers, 1, [&](size_type first, size_type last)
+    {
+        for (size_type k = first; k < last; ++k)
+            hogwilding(k, idata, odata, samples,
+                       k * iteration_scale / workers,
+                       (k + 1) * iteration_scale / workers,
+                       optimizer);
+    });
+
+    sharing(false);
 }
 
 TRIXY_TRAINING_TEMPLATE()
@@ -174,8 +441,6 @@ void UnifiedNetTraining<Trainable>::batch(
         {
             feedforward(idata[sample]);
             backprop(idata[sample], odata[sample]);
-
-            accumulating();
         }
 
         updating(optimizer, alpha);
@@ -190,39 +455,150 @@ void UnifiedNetTraining<Trainable>::mini_batch(
     size_type number_of_epochs,
     size_type mini_batch_size) noexcept
 {
-    precision_type alpha = 1. / static_cast<precision_type>(mini_batch_size);
+    mini_batching(idata, odata, idata.size(), optimizer, number_of_epochs, mini_batch_size);
+}
 
-    // number of iterations per full batch
-    size_type iteration_scale = idata.size() / mini_batch_size; // implicit drop floating part
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::mini_batch(
+    const Batch& idata,
+    const Batch& odata,
+    IOptimizer& optimizer,
+    size_type number_of_epochs,
+    size_type mini_batch_size) noexcept
+{
+    mini_batching(idata, odata, idata.batch(), optimizer, number_of_epochs, mini_batch_size);
+}
 
-    size_type sample;
-    size_type sample_limit;
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::local_mini_batch(
+    const Container<Tensor>& idata,
+    const Container<Tensor>& odata,
+    IOptimizer& optimizer,
+    size_type number_of_epochs,
+    size_type mini_batch_size,
+    size_type averaging_period) noexcept
+{
+    local_mini_batching(idata, odata, idata.size(),
+                        optimizer, number_of_epochs, mini_batch_size, averaging_period);
+}
 
-    for (size_type epoch = 0, iteration; epoch < number_of_epochs; ++epoch)
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::local_mini_batch(
+    const Batch& idata,
+    const Batch& odata,
+    IOptimizer& optimizer,
+    size_type number_of_epochs,
+    size_type mini_batch_size,
+    size_type averaging_period) noexcept
+{
+    local_mini_batching(idata, odata, idata.batch(),
+                        optimizer, number_of_epochs, mini_batch_size, averaging_period);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Channel>
+void UnifiedNetTraining<Trainable>::parameter_server(
+    Channel& channel,
+    IOptimizer& optimizer,
+    size_type number_of_updates,
+    size_type max_staleness) noexcept
+{
+    Vector flat(channel.size());
+
+    auto pack = [&flat](precision_type* data, size_type size, size_type offset)
     {
-        sample = 0;
-        sample_limit = 0;
+        std::copy(data, data + size, flat.data() + offset);
+    };
 
-        for (iteration = 0; iteration < iteration_scale; ++iteration)
+    // workers may pull parameters only after all of them have attached to channel
+    channel.wait_workers();
+
+    flattening(false, pack);
+    channel.publish(flat.data());
+
+    for (size_type updates = 0; updates < number_of_updates; )
+    {
+        bool is_idle = true;
+
+        for (size_type worker = 0; worker < channel.workers() and updates < number_of_updates; ++worker)
         {
-            sample_limit += mini_batch_size;
+            typename Channel::version_type staleness = 0;
 
-            reseting();
+            auto gradients = channel.take(worker, staleness);
+            if (gradients == nullptr) continue;
 
-            // accumulating deltas for one mini-batch
-            while (sample < sample_limit)
+            is_idle = false;
+
+            if (staleness <= max_staleness)
             {
-                feedforward(idata[sample]);
-                backprop(idata[sample], odata[sample]);
+                flattening(true, [gradients](precision_type* data, size_type size, size_type offset)
+                {
+                    std::copy(gradients + offset, gradients + offset + size, data);
+                });
 
-                accumulating();
+                updating(optimizer, 1.f);
+                ++updates;
 
-                ++sample;
+                flattening(false, pack);
+                channel.publish(flat.data());
             }
-            // averaging deltas for one mini-batch
-            updating(optimizer, alpha);
+
+            channel.release(worker);
         }
+
+        if (is_idle) std::this_thread::yield();
     }
+
+    channel.stop();
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Channel, class GeneratorInteger>
+void UnifiedNetTraining<Trainable>::parameter_worker(
+    Channel& channel,
+    size_type worker,
+    const Container<Tensor>& idata,
+    const Container<Tensor>& odata,
+    size_type mini_batch_size,
+    GeneratorInteger generator) noexcept
+{
+    const precision_type alpha = 1. / static_cast<precision_type>(mini_batch_size);
+
+    Vector flat(channel.size());
+    typename Channel::version_type version = 0;
+
+    while (channel.pull(flat.data(), version))
+    {
+        flattening(false, [&flat](precision_type* data, size_type size, size_type offset)
+        {
+            std::copy(flat.data() + offset, flat.data() + offset + size, data);
+        });
+
+        reseting();
+
+        for (size_type n = 0, sample; n < mini_batch_size; ++n)
+        {
+            sample = generator() % idata.size();
+
+            feedforward(idata[sample]);
+            backprop(idata[sample], odata[sample]);
+        }
+
+        // server applies averaged gradients as they are
+        flattening(true, [&flat, alpha](precision_type* data, size_type size, size_type offset)
+        {
+            for (size_type i = 0; i < size; ++i) flat(offset + i) = alpha * data[i];
+        });
+
+        if (not channel.push(worker, flat.data(), version)) break;
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+typename UnifiedNetTraining<Trainable>::size_type
+    UnifiedNetTraining<Trainable>::parameter_count() noexcept
+{
+    return flattening(false, [](precision_type*, size_type, size_type) {});
 }
 
 TRIXY_TRAINING_TEMPLATE()
@@ -237,16 +613,22 @@ void UnifiedNetTraining<Trainable>::backprop(
     const Tensor& sample,
     const Tensor& target) noexcept
 {
-    const size_type N = net.size();
-
-    loss_->df(delta, target, layer(N - 1).value());
-
-    layer(N - 1).backward(layer(N - 2).value(), delta);
+    backpropagating([this](size_type i) -> ITrainLayer& { return layer(i); }, sample, target, delta);
+}
 
-    for (size_type i = N - 2; i > 0; --i)
-        layer(i).backward(layer(i - 1).value(), layer(i + 1).delta());
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::feedforward_batch(
+    const Matrix& batch) noexcept
+{
+    net.feedforward_batch(batch);
+}
 
-    layer(0).backward(sample, layer(1).delta(), false);
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::backprop_batch(
+    const Matrix& batch,
+    const Matrix& target) noexcept
+{
+    backpropagating([this](size_type i) -> ITrainLayer& { return layer(i); }, batch, target, batch_delta);
 }
 
 TRIXY_TRAINING_TEMPLATE()
@@ -277,6 +659,17 @@ typename UnifiedNetTraining<Trainable>::ITrainLayer&
 TRIXY_TRAINING_TEMPLATE()
 void UnifiedNetTraining<Trainable>::updating(IOptimizer& optimizer, precision_type alpha) noexcept
 {
+    if (is_flat())
+    {
+        // layers without backward since reset fill their part of arena by zeros
+        visiting(true, [](TensorBase&) {});
+
+        if (alpha != 1.f) net.linear.join(flat_gradients_, alpha);
+
+        optimizer.update(optimizer.flat_slot(), flat_parameters_, flat_gradients_);
+        return;
+    }
+
     for (size_type i = 0; i < net.size(); ++i) layer(i).update(optimizer, alpha);
 }
 
@@ -287,9 +680,544 @@ void UnifiedNetTraining<Trainable>::reseting() noexcept
 }
 
 TRIXY_TRAINING_TEMPLATE()
-void UnifiedNetTraining<Trainable>::accumulating() noexcept
+template <class Samples, class Targets>
+void UnifiedNetTraining<Trainable>::mini_batching(
+    const Samples& idata,
+    const Targets& odata,
+    size_type sample_count,
+    IOptimizer& optimizer,
+    size_type number_of_epochs,
+    size_type mini_batch_size) noexcept
+{
+    precision_type alpha = 1. / static_cast<precision_type>(mini_batch_size);
+
+    // number of iterations per full batch
+    size_type iteration_scale = sample_count / mini_batch_size; // implicit drop floating part
+
+    size_type sample;
+    size_type sample_limit;
+
+    const bool is_distributed = communicator_ != nullptr and communicator_->size() > 1;
+
+    const size_type workers = is_distributed ? 1 : pool_.size();
+
+    // replicas read parameters of network, so they own only caches and gradient shards
+    if (workers > 1)
+    {
+        replicating();
+        sharing(true);
+    }
+
+    if (is_distributed) broadcasting();
+
+    for (size_type epoch = 0, iteration; epoch < number_of_epochs; ++epoch)
+    {
+        sample = 0;
+        sample_limit = 0;
+
+        for (iteration = 0; iteration < iteration_scale; ++iteration)
+        {
+            sample_limit += mini_batch_size;
+
+            reseting();
+
+            if (is_distributed)
+            {
+                // each process accumulates deltas for its part of mini-batch
+                const size_type rank = communicator_->rank();
+                const size_type ranks = communicator_->size();
+
+                distributing(idata, odata,
+                             sample + rank * mini_batch_size / ranks,
+                             sample + (rank + 1) * mini_batch_size / ranks);
+            }
+            else if (workers == 1)
+            {
+                utility::gather_batch(batch_sample, idata, sample, sample_limit);
+                utility::gather_batch(batch_target, odata, sample, sample_limit);
+
+                // accumulating deltas for one mini-batch at once
+                feedforward_batch(batch_sample);
+                backprop_batch(batch_sample, batch_target);
+            }
+            else
+            {
+                // each worker accumulates deltas for its part of mini-batch
+                pool_.parallel_for(workers, 1, [&](size_type first, size_type last)
+                {
+                    for (size_type k = first; k < last; ++k)
+                        sharding(k, idata, odata,
+                                 sample + k * mini_batch_size / workers,
+                                 sample + (k + 1) * mini_batch_size / workers);
+                });
+
+                // pairwise tree reduction of gradient shards to the network layers
+                for (size_type step = 1; step < workers; step *= 2)
+                {
+                    const size_type pairs = (workers - step + 2 * step - 1) / (2 * step);
+
+                    pool_.parallel_for(pairs, 1, [&](size_type first, size_type last)
+                    {
+                        for (size_type pair = first; pair < last; ++pair)
+                        {
+                            const size_type k = 2 * step * pair;
+                            auto& source = replicas_[k + step].inner;
+
+                            for (size_type i = 0; i < net.size(); ++i)
+                            {
+                                auto& target = k == 0 ? layer(i) : *replicas_[k].inner[i];
+                                target.merge(*source[i]);
+                            }
+                        }
+                    });
+                }
+            }
+
+            sample = sample_limit;
+
+            // averaging deltas for one mini-batch
+            updating(optimizer, alpha);
+        }
+    }
+
+    if (workers > 1) sharing(false);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Samples, class Targets>
+void UnifiedNetTraining<Trainable>::local_mini_batching(
+    const Samples& idata,
+    const Targets& odata,
+    size_type sample_count,
+    IOptimizer& optimizer,
+    size_type number_of_epochs,
+    size_type mini_batch_size,
+    size_type averaging_period) noexcept
+{
+    const size_type workers = pool_.size();
+
+    if (workers == 1)
+        return mini_batching(idata, odata, sample_count, optimizer, number_of_epochs, mini_batch_size);
+
+    replicating();
+
+    // all replicas start from parameters of network
+    for (size_type k = 1; k < workers; ++k)
+        for (size_type i = 0; i < net.size(); ++i)
+            replicas_[k].inner[i]->synchronize(layer(i));
+
+    const size_type shard_size = sample_count / workers;
+
+    // number of iterations per shard
+    const size_type iteration_scale = shard_size / mini_batch_size; // implicit drop floating part
+
+    if (number_of_epochs == 0 or iteration_scale == 0) return;
+
+    // each replica has own parameters, so own copy of optimizer state, step counts included,
+    // replicas update only their own slots and do not share any state of optimizer
+    optimizer.bind(workers);
+
+    for (size_type k = 1; k < workers; ++k)
+        for (size_type i = 0, slot = k * optimizer.slot_count(); i < net.size(); ++i)
+        {
+            replicas_[k].inner[i]->bind(slot);
+            layer(i).parameters([&slot](TensorBase&) { ++slot; });
+        }
+
+    for (size_type epoch = 0, iteration; epoch < number_of_epochs; ++epoch)
+    {
+        for (iteration = 0; iteration < iteration_scale; iteration += averaging_period)
+        {
+            const size_type limit = iteration + averaging_period < iteration_scale
+                                  ? iteration + averaging_period : iteration_scale;
+
+            // replicas are trained independently until the next averaging
+            pool_.parallel_for(workers, 1, [&](size_type first, size_type last)
+            {
+                for (size_type k = first; k < last; ++k)
+                    localing(k, idata, odata,
+                             k * shard_size + iteration * mini_batch_size,
+                             k * shard_size + limit * mini_batch_size,
+                             mini_batch_size, optimizer);
+            });
+
+            averaging();
+        }
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Layer>
+void UnifiedNetTraining<Trainable>::backpropagating(
+    Layer layer,
+    const Tensor& sample,
+    const Tensor& target,
+    Tensor& delta) noexcept
+{
+    // layer(i) - i-th layer of network or of its replica
+    const size_type N = net.size();
+
+    loss_->df(delta, target, layer(N - 1).value());
+
+    layer(N - 1).backward(layer(N - 2).value(), delta);
+
+    for (size_type i = N - 2; i > 0; --i)
+        layer(i).backward(layer(i - 1).value(), layer(i + 1).delta());
+
+    layer(0).backward(sample, layer(1).delta(), false);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Layer>
+void UnifiedNetTraining<Trainable>::backpropagating(
+    Layer layer,
+    const Matrix& batch,
+    const Matrix& target,
+    Matrix& delta) noexcept
+{
+    backpropagating(layer, batch, target, delta, [](size_type) {});
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Layer, class Callback>
+void UnifiedNetTraining<Trainable>::backpropagating(
+    Layer layer,
+    const Matrix& batch,
+    const Matrix& target,
+    Matrix& delta,
+    Callback callback) noexcept
+{
+    using Range = typename ILoss::Range;
+
+    // layer(i) - i-th layer of network or of its replica
+    const size_type N = net.size();
+
+    const size_type batch_size = target.shape().height;
+    const size_type width = target.shape().width;
+
+    utility::resize_batch(delta, batch_size, width);
+
+    // rows are passed by ranges of whole tensors, as tensors are passed for single sample
+    Range targets = target;
+    Range predictions = layer(N - 1).batch_value();
+
+    auto y_true = targets.data();
+    auto y_pred = predictions.data();
+    auto result = delta.data();
+
+    // loss is defined for single sample
+    for (size_type n = 0; n < batch_size; ++n, y_true += width, y_pred += width, result += width)
+        loss_->df(Range(result, result + width), Range(y_true, y_true + width), Range(y_pred, y_pred + width));
+
+    // callback(i) - gradients of i-th layer are final
+    layer(N - 1).backward_batch(layer(N - 2).batch_value(), delta);
+    callback(N - 1);
+
+    for (size_type i = N - 2; i > 0; --i)
+    {
+        layer(i).backward_batch(layer(i - 1).batch_value(), layer(i + 1).batch_delta());
+        callback(i);
+    }
+
+    layer(0).backward_batch(batch, layer(1).batch_delta(), false);
+    callback(0);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Samples, class Targets>
+void UnifiedNetTraining<Trainable>::sharding(
+    size_type worker,
+    const Samples& idata,
+    const Targets& odata,
+    size_type first,
+    size_type last) noexcept
+{
+    auto& replica = replicas_[worker];
+
+    auto node = [this, worker, &replica](size_type i) -> ITrainLayer&
+    {
+        return worker == 0 ? layer(i) : *replica.inner[i];
+    };
+
+    // replica shares parameters of network and starts with empty gradients
+    if (worker > 0)
+        for (size_type i = 0; i < net.size(); ++i) node(i).reset();
+
+    if (first == last) return;
+
+    utility::gather_batch(replica.batch_sample, idata, first, last);
+    utility::gather_batch(replica.batch_target, odata, first, last);
+
+    node(0).forward_batch(replica.batch_sample);
+
+    for (size_type i = 1; i < net.size(); ++i)
+        node(i).forward_batch(node(i - 1).batch_value());
+
+    backpropagating(node, replica.batch_sample, replica.batch_target, replica.batch_delta);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::hogwilding(
+    size_type worker,
+    const Container<Tensor>& idata,
+    const Container<Tensor>& odata,
+    const Container<size_type>& samples,
+    size_type first,
+    size_type last,
+    IOptimizer& optimizer) noexcept
+{
+    auto& replica = replicas_[worker];
+
+    // replica has own caches and gradients, but shares parameters of network
+    auto node = [this, worker, &replica](size_type i) -> ITrainLayer&
+    {
+        return worker == 0 ? layer(i) : *replica.inner[i];
+    };
+
+    auto& error = worker == 0 ? delta : replica.delta;
+
+    for (size_type iteration = first; iteration < last; ++iteration)
+    {
+        auto& sample = idata[samples[iteration]];
+        auto& target = odata[samples[iteration]];
+
+        for (size_type i = 0; i < net.size(); ++i) node(i).reset();
+
+        node(0).forward(sample);
+
+        for (size_type i = 1; i < net.size(); ++i)
+            node(i).forward(node(i - 1).value());
+
+        backpropagating(node, sample, target, error);
+
+        for (size_type i = 0; i < net.size(); ++i) node(i).update(optimizer, 1.f);
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Samples, class Targets>
+void UnifiedNetTraining<Trainable>::localing(
+    size_type worker,
+    const Samples& idata,
+    const Targets& odata,
+    size_type first,
+    size_type last,
+    size_type mini_batch_size,
+    IOptimizer& optimizer) noexcept
+{
+    auto& replica = replicas_[worker];
+
+    // replica has own parameters, caches and gradients
+    auto node = [this, worker, &replica](size_type i) -> ITrainLayer&
+    {
+        return worker == 0 ? layer(i) : *replica.inner[i];
+    };
+
+    const precision_type alpha = 1. / static_cast<precision_type>(mini_batch_size);
+
+    for (size_type sample = first; sample < last; sample += mini_batch_size)
+    {
+        for (size_type i = 0; i < net.size(); ++i) node(i).reset();
+
+        utility::gather_batch(replica.batch_sample, idata, sample, sample + mini_batch_size);
+        utility::gather_batch(replica.batch_target, odata, sample, sample + mini_batch_size);
+
+        node(0).forward_batch(replica.batch_sample);
+
+        for (size_type i = 1; i < net.size(); ++i)
+            node(i).forward_batch(node(i - 1).batch_value());
+
+        backpropagating(node, replica.batch_sample, replica.batch_target, replica.batch_delta);
+
+        for (size_type i = 0; i < net.size(); ++i) node(i).update(optimizer, alpha);
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::averaging() noexcept
+{
+    const size_type workers = replicas_.size();
+
+    // layers are independent, so each of them is averaged by own thread
+    pool_.parallel_for(net.size(), 1, [&](size_type first, size_type last)
+    {
+        for (size_type i = first; i < last; ++i)
+            for (size_type k = 1; k < workers; ++k)
+                layer(i).average(*replicas_[k].inner[i], 1. / static_cast<precision_type>(k + 1));
+    });
+
+    pool_.parallel_for(workers - 1, 1, [&](size_type first, size_type last)
+    {
+        for (size_type k = first + 1; k < last + 1; ++k)
+            for (size_type i = 0; i < net.size(); ++i)
+                replicas_[k].inner[i]->synchronize(layer(i));
+    });
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Samples, class Targets>
+void UnifiedNetTraining<Trainable>::distributing(
+    const Samples& idata,
+    const Targets& odata,
+    size_type first,
+    size_type last) noexcept
+{
+    auto push = [this](TensorBase& tensor) { reducer_->push(tensor.data(), tensor.size()); };
+
+    if (first < last)
+    {
+        utility::gather_batch(batch_sample, idata, first, last);
+        utility::gather_batch(batch_target, odata, first, last);
+
+        feedforward_batch(batch_sample);
+
+        // gradients of the last layers are reduced while the first ones are still computed
+        backpropagating([this](size_type i) -> ITrainLayer& { return layer(i); },
+                        batch_sample, batch_target, batch_delta,
+                        [this, &push](size_type i) { layer(i).gradients(push); });
+    }
+    else
+    {
+        // process without samples takes part in reduction with empty gradients
+        for (size_type i = net.size(); i > 0; --i) layer(i - 1).gradients(push);
+    }
+
+    reducer_->wait();
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::broadcasting() noexcept
+{
+    // sum of parameters of rank 0 and of zeros of other ranks
+    const bool is_root = communicator_->rank() == 0;
+
+    for (size_type i = 0; i < net.size(); ++i)
+    {
+        layer(i).parameters([this, is_root](TensorBase& tensor)
+        {
+            if (not is_root) tensor.fill(0.f);
+            communicator_->allreduce(tensor.data(), tensor.size());
+        });
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Function>
+typename UnifiedNetTraining<Trainable>::size_type
+    UnifiedNetTraining<Trainable>::flattening(bool is_gradient, Function function) noexcept
+{
+    size_type offset = 0;
+
+    visiting(is_gradient, [&function, &offset](TensorBase& tensor)
+    {
+        function(tensor.data(), tensor.size(), offset);
+        offset += tensor.size();
+    });
+
+    return offset;
+}
+
+TRIXY_TRAINING_TEMPLATE()
+template <class Function>
+void UnifiedNetTraining<Trainable>::visiting(bool is_gradient, Function function) noexcept
+{
+    for (size_type i = 0; i < net.size(); ++i)
+    {
+        if (is_gradient) layer(i).gradients(function);
+        else layer(i).parameters(function);
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+typename UnifiedNetTraining<Trainable>::Vector
+    UnifiedNetTraining<Trainable>::arranging(bool is_gradient)
+{
+    size_type size = 0;
+    visiting(is_gradient, [&size](TensorBase& tensor)
+    {
+        size += trixy::detail::padded<precision_type>(tensor.size());
+    });
+
+    Vector arena(size, precision_type(0));
+
+    auto data = arena.data();
+    visiting(is_gradient, [&data](TensorBase& tensor)
+    {
+        TensorBase view(tensor.shape(), data);
+        view.copy(tensor);
+
+        // tensor takes the view and gives back own buffer
+        tensor.swap(view);
+        trixy::detail::deallocate(view.data());
+
+        data += trixy::detail::padded<precision_type>(tensor.size());
+    });
+
+    return arena;
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::flatten()
+{
+    if (is_flat()) return;
+
+    flat_parameters_ = arranging(false);
+    flat_gradients_ = arranging(true);
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::unflatten()
+{
+    if (not is_flat()) return;
+
+    for (bool is_gradient : { false, true })
+    {
+        visiting(is_gradient, [](TensorBase& tensor)
+        {
+            TensorBase own(tensor.shape(), trixy::detail::allocate<precision_type>(tensor.size()));
+            own.copy(tensor);
+
+            tensor.swap(own);
+        });
+    }
+
+    flat_parameters_ = Vector();
+    flat_gradients_ = Vector();
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::replicating()
+{
+    if (replicas_.size() == pool_.size()) return;
+
+    releasing();
+
+    replicas_.resize(pool_.size());
+
+    for (size_type k = 1; k < replicas_.size(); ++k)
+    {
+        for (size_type i = 0; i < net.size(); ++i)
+            replicas_[k].inner.emplace_back(layer(i).replicate());
+
+        replicas_[k].delta.resize(net.inner().back()->osize());
+    }
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::releasing() noexcept
+{
+    for (auto& replica : replicas_)
+        for (auto layer : replica.inner) delete layer;
+
+    replicas_ = Container<Replica>();
+}
+
+TRIXY_TRAINING_TEMPLATE()
+void UnifiedNetTraining<Trainable>::sharing(bool is_shared) noexcept
 {
-    for (size_type i = 0; i < net.size(); ++i) layer(i).accumulate();
+    for (size_type k = 1; k < replicas_.size(); ++k)
+        for (size_type i = 0; i < net.size(); ++i)
+            replicas_[k].inner[i]->share(is_shared ? &layer(i) : nullptr);
 }
 
 } // namespace train
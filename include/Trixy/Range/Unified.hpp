@@ -5,6 +5,8 @@
 
 #include <Trixy/Range/Base.hpp>
 
+#include <Trixy/Detail/MemoryDetail.hpp>
+
 namespace trixy
 {
 
@@ -30,7 +32,7 @@ public:
     Range() : first_(nullptr), size_(0) {}
 
     Range(size_type size)
-        : first_(new value_type [size]), size_(size)
+        : first_(detail::allocate<value_type>(size)), size_(size)
     {
     }
 
@@ -42,7 +44,7 @@ public:
 
     ~Range()
     {
-        delete[] first_;
+        detail::deallocate(first_);
     }
 
     void fill(value_type value)
@@ -55,9 +57,9 @@ public:
 
     void resize(size_type size)
     {
-        delete[] first_;
+        detail::deallocate(first_);
 
-        first_ = new value_type [size];
+        first_ = detail::allocate<value_type>(size);
         size_  = size;
     }
 
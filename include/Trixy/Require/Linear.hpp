@@ -31,6 +31,9 @@ protected:
 
     using require::dot;
     using require::tensordot;
+    using require::tensordot_add;
+    using require::dot_tensordot;
+    using require::dot_tensordot_add;
     using require::transpose;
     using require::inverse;
 
@@ -40,6 +43,8 @@ protected:
     using require::join;
 
     using require::apply;
+    using require::assign;
+    using require::fuse;
 
     using require::loop;
 };
@@ -0,0 +1,166 @@
+#ifndef TRIXY_THREAD_HPP
+#define TRIXY_THREAD_HPP
+
+#include <cstddef> // size_t
+#include <condition_variable> // condition_variable
+#include <functional> // function
+#include <mutex> // mutex, lock_guard, unique_lock
+#include <queue> // queue
+#include <thread> // thread
+#include <vector> // vector
+
+namespace trixy
+{
+
+namespace utility
+{
+
+// Fork-join pool: caller splits range of work between itself and workers and waits for all of them
+class ThreadPool
+{
+public:
+    using size_type = std::size_t;
+    using Task      = std::function<void()>;
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<Task> tasks_;
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+
+    bool is_stopped_ = false;
+
+public:
+    // size - total number of threads including caller, 0 - number of hardware threads
+    explicit ThreadPool(size_type size = 0) { start(size); }
+    ~ThreadPool() { stop(); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator= (const ThreadPool&) = delete;
+
+    void resize(size_type size)
+    {
+        stop();
+        start(size);
+    }
+
+    size_type size() const noexcept { return workers_.size() + 1; }
+
+    // Call function(first, last) on blocks of range [0, size), block is not less than min_per_thread,
+    // nested calls from workers are executed by calling thread only
+    template <class Function>
+    void parallel_for(size_type size, size_type min_per_thread, Function function);
+
+    static bool is_worker() noexcept { return worker_flag(); }
+
+private:
+    void start(size_type size);
+    void stop();
+
+    void work();
+
+    static bool& worker_flag() noexcept
+    {
+        thread_local bool is_worker = false;
+        return is_worker;
+    }
+};
+
+template <class Function>
+void ThreadPool::parallel_for(size_type size, size_type min_per_thread, Function function)
+{
+    const size_type max_threads = min_per_thread == 0 ? size : size / min_per_thread;
+    const size_type number_of_threads = max_threads < this->size() ? max_threads : this->size();
+
+    if (number_of_threads < 2 || is_worker())
+    {
+        function(size_type(0), size);
+        return;
+    }
+
+    const size_type block_size = size / number_of_threads;
+
+    // locals of caller, so workers touch them only under done_mutex: caller returns once it sees remaining == 0
+    size_type remaining = number_of_threads - 1;
+
+    std::mutex done_mutex;
+    std::condition_variable done;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_type i = 1; i < number_of_threads; ++i)
+        {
+            const size_type first = i * block_size;
+            const size_type last = i + 1 == number_of_threads ? size : first + block_size;
+
+            tasks_.emplace([&, first, last]
+            {
+                function(first, last);
+
+                std::lock_guard<std::mutex> lock(done_mutex);
+                if (--remaining == 0) done.notify_one();
+            });
+        }
+    }
+
+    condition_.notify_all();
+
+    function(size_type(0), block_size);
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&remaining] { return remaining == 0; });
+}
+
+inline void ThreadPool::start(size_type size)
+{
+    if (size == 0) size = std::thread::hardware_concurrency();
+    if (size == 0) size = 1;
+
+    is_stopped_ = false;
+
+    workers_.reserve(size - 1);
+    for (size_type i = 1; i < size; ++i)
+        workers_.emplace_back(&ThreadPool::work, this);
+}
+
+inline void ThreadPool::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_stopped_ = true;
+    }
+
+    condition_.notify_all();
+
+    for (auto& worker : workers_) worker.join();
+    workers_.clear();
+}
+
+inline void ThreadPool::work()
+{
+    worker_flag() = true;
+
+    while (true)
+    {
+        Task task;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return is_stopped_ || not tasks_.empty(); });
+
+            if (tasks_.empty()) return;
+
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+
+        task();
+    }
+}
+
+} // namespace utility
+
+} // namespace trixy
+
+#endif // TRIXY_THREAD_HPP
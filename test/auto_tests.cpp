@@ -47,6 +47,520 @@ TEST(TestLique, TestTensor)
     }
 }
 
+TEST(TestLique, TestAlignment)
+{
+    auto aligned = [](const void* data)
+    {
+        return reinterpret_cast<std::uintptr_t>(data) % trixy::detail::alignment == 0;
+    };
+
+    {
+        Core::Vector x(7);
+        Core::Matrix y(3, 5);
+        Core::Tensor z(2, 3, 5);
+
+        EXPECT("tensor", aligned(x.data()) && aligned(y.data()) && aligned(z.data()));
+
+        y.resize(9, 13);
+        Core::Matrix w = y;
+
+        EXPECT("copy", aligned(y.data()) && aligned(w.data()));
+    }
+    {
+        trixy::utility::Range<float, trixy::RangeType::Unified> x(37);
+
+        EXPECT("range", aligned(x.data()));
+    }
+
+    EXPECT("padded", trixy::detail::padded<float>(1) == trixy::detail::alignment / sizeof(float)
+                  && trixy::detail::padded<double>(trixy::detail::alignment / sizeof(double)) == trixy::detail::alignment / sizeof(double));
+}
+
+TEST(TestLique, TestAllocator)
+{
+    {
+        trixy::memory::PoolAllocator pool;
+        {
+            trixy::memory::AllocatorScope scope(pool);
+
+            Core::Matrix x(30, 40);
+            const void* data = x.data();
+
+            x.resize(40, 30);
+
+            EXPECT("reuse", x.data() == data && pool.stat().in_use > 0 && pool.stat().count == 2);
+        }
+
+        // memory of unbound tensor is still returned to its pool
+        Core::Vector y(16);
+        EXPECT("bound", trixy::memory::current_allocator().stat().count > 0 && pool.stat().in_use == 0);
+    }
+    {
+        trixy::memory::ArenaAllocator arena(1 << 12);
+        {
+            trixy::memory::ArenaScope scope(arena);
+
+            Core::Vector x(100);
+            Core::Vector y(1000, 1.f);
+
+            Core::Linear linear;
+            Core::Vector z = x; // temporary copies go to arena as well
+            linear.add(z, y);
+
+            auto aligned = [](const void* data)
+            {
+                return reinterpret_cast<std::uintptr_t>(data) % trixy::detail::alignment == 0;
+            };
+
+            EXPECT("aligned", aligned(x.data()) && aligned(y.data()) && aligned(z.data()));
+            EXPECT("stat", arena.stat().count == 3 && arena.stat().peak >= 1200 * sizeof(float));
+        }
+
+        EXPECT("reset", arena.stat().in_use == 0);
+    }
+}
+
+TEST(TestLique, TestBatch)
+{
+    trixy::utility::Container<Core::Tensor> samples;
+    samples.emplace_back(2, 1, 3, 1.f);
+    samples.emplace_back(2, 1, 3, 2.f);
+
+    Core::Batch batch(samples);
+    batch(1, 1, 0, 2) = 5.f;
+
+    EXPECT("shape",
+        batch.batch() == 2 && batch.sample_shape().size == 6 &&
+        batch.shape().height == 2 && batch.shape().width == 6 &&
+        batch.batch_shape().size == 12
+    );
+
+    auto sample = batch.sample(1);
+
+    EXPECT("sample", sample.data() == batch.data() + 6 && sample(0, 0, 0) == 2.f && sample(1, 0, 2) == 5.f);
+
+    batch.resize(trixy::lique::BatchShape<std::size_t>(3, 1, 2, 2));
+
+    EXPECT("resize", batch.batch() == 3 && batch.shape().width == 4 && batch.sample(2).shape().height == 2);
+}
+
+TEST(TestLique, TestLinearDot)
+{
+    Core::Linear linear;
+
+    // sizes are chosen to hit tails of register tile and cache blocks
+    Core::size_type sizes[][3] = { {3, 5, 7}, {37, 53, 71}, {130, 300, 70} };
+
+    for (auto& size : sizes)
+    {
+        Core::size_type m = size[0];
+        Core::size_type k = size[1];
+        Core::size_type n = size[2];
+
+        Core::Matrix lhs(m, k);
+        Core::Matrix rhs(k, n);
+
+        Core::precision_type value = 0;
+        lhs.fill([&value] { return value = value > 1 ? -1 : value + 0.125f; });
+        rhs.fill([&value] { return value = value > 1 ? -1 : value + 0.25f; });
+
+        Core::Matrix x(m, n, 1.f);
+        linear.dot(x, lhs, rhs);
+
+        bool is_equal = true;
+        for (Core::size_type i = 0; i < m; ++i)
+        {
+            for (Core::size_type j = 0; j < n; ++j)
+            {
+                Core::precision_type expected = 1.f;
+                for (Core::size_type r = 0; r < k; ++r)
+                    expected += lhs(i, r) * rhs(r, j);
+
+                is_equal = is_equal && std::fabs(x(i, j) - expected) < 1e-3f;
+            }
+        }
+
+        EXPECT("value", is_equal);
+    }
+}
+
+TEST(TestLique, TestStrided)
+{
+    using StridedView = trixy::lique::StridedView<Core::precision_type>;
+
+    Core::Tensor x(3, 4, 5);
+
+    Core::precision_type value = 0;
+    x.fill([&value] { return value += 1.f; });
+
+    {
+        StridedView view(x);
+        StridedView slice = view.channels(1, 3).rows(1, 3).cols(2, 5);
+
+        EXPECT("contiguous", view.contiguous() && !slice.contiguous() && view.channels(1, 2).contiguous());
+        EXPECT("slice", slice.shape().depth == 2 && slice.shape().height == 2 && slice.shape().width == 3
+                     && slice(0, 0, 0) == x(1, 1, 2) && slice(1, 1, 2) == x(2, 2, 4));
+
+        StridedView transposed = view.transpose();
+        EXPECT("transpose", transposed.shape().height == 5 && transposed.shape().width == 4
+                         && transposed(2, 3, 1) == x(2, 1, 3));
+    }
+    {
+        Core::Linear linear;
+
+        Core::Matrix lhs(67, 19);
+        Core::Matrix rhs(67, 23);
+
+        lhs.fill([&value] { return value = value > 1 ? -1 : value + 0.125f; });
+        rhs.fill([&value] { return value = value > 1 ? -1 : value + 0.25f; });
+
+        // lhs^T . rhs by transposed view and by transposed copy
+        Core::Matrix expected = linear.dot(linear.transpose(lhs), rhs);
+
+        Core::Matrix result(19, 23, 0.f);
+        linear.dot(result, StridedView(lhs).transpose(), rhs);
+
+        bool is_equal = true;
+        for (Core::size_type i = 0; i < result.size(); ++i)
+            is_equal = is_equal && std::fabs(result(i) - expected(i)) < 1e-3f;
+
+        EXPECT("dot", is_equal);
+    }
+}
+
+TEST(TestLique, TestLinearDotBias)
+{
+    Core::Linear linear;
+
+    // width is not multiple of the block and of the register tile
+    const Core::size_type k = 19;
+    const Core::size_type n = 300;
+
+    Core::Vector x(k);
+    Core::Matrix w(k, n);
+    Core::Vector b(n);
+
+    Core::precision_type value = 0;
+    x.fill([&value] { return value = value > 1 ? -1 : value + 0.125f; });
+    w.fill([&value] { return value = value > 1 ? -1 : value + 0.25f; });
+    b.fill([&value] { return value = value > 1 ? -1 : value + 0.5f; });
+
+    Core::Vector y(n, 0.f);
+    Core::size_type finished = 0;
+
+    // each block is squared once it is finished
+    linear.dot(y, x, w, b, [&](Core::size_type first, Core::size_type last)
+    {
+        finished = finished == first ? last : n + 1;
+        for (Core::size_type j = first; j < last; ++j) y(j) *= y(j);
+    });
+
+    bool is_equal = finished == n;
+    for (Core::size_type j = 0; j < n; ++j)
+    {
+        Core::precision_type expected = b(j);
+        for (Core::size_type i = 0; i < k; ++i)
+            expected += x(i) * w(i, j);
+
+        is_equal = is_equal && std::fabs(y(j) - expected * expected) < 1e-3f;
+    }
+
+    EXPECT("value", is_equal);
+}
+
+TEST(TestLique, TestLinearElementwise)
+{
+    Core::Linear linear;
+
+    // odd size to hit scalar tail after the packed part
+    const Core::size_type n = 37;
+
+    Core::Vector lhs(n);
+    Core::Vector rhs(n);
+
+    Core::precision_type value = 0;
+    lhs.fill([&value] { return value += 0.5f; });
+    rhs.fill([&value] { return value -= 0.25f; });
+
+    Core::Vector sum(n, 1.f);
+    linear.add(sum, lhs);
+
+    Core::Vector diff(n);
+    linear.sub(diff, lhs, rhs);
+
+    Core::Vector prod(n);
+    linear.mul(prod, lhs, rhs);
+
+    Core::Vector scaled(n);
+    linear.join(scaled, 2.f, rhs);
+
+    Core::Vector copied(n);
+    linear.assign(copied, lhs);
+
+    bool is_equal = true;
+    for (Core::size_type i = 0; i < n; ++i)
+    {
+        is_equal = is_equal &&
+            sum(i) == 1.f + lhs(i) &&
+            diff(i) == lhs(i) - rhs(i) &&
+            prod(i) == lhs(i) * rhs(i) &&
+            scaled(i) == 2.f * rhs(i) &&
+            copied(i) == lhs(i);
+    }
+
+    EXPECT("value", is_equal);
+}
+
+TEST(TestLique, TestLazy)
+{
+    using trixy::lique::lazy::ref;
+
+    Core::Linear linear;
+
+    // odd size to hit scalar tail after the packed part
+    const Core::size_type n = 37;
+
+    Core::Vector x(n);
+    Core::Vector y(n);
+
+    Core::precision_type value = 0;
+    x.fill([&value] { return value += 0.5f; });
+    y.fill([&value] { return value -= 0.25f; });
+
+    const Core::Vector& cx = x;
+
+    Core::Vector result(n, 1.f);
+    linear.assign(result, 2.f * ref(cx) + ref(y) / (1.f + ref(cx) * ref(x)));
+
+    Core::Vector root(n, 0.f);
+    ref(root) = sqrt(ref(x));
+    ref(root) -= 0.5f - ref(y);
+
+    bool is_equal = true;
+    for (Core::size_type i = 0; i < n; ++i)
+    {
+        is_equal = is_equal &&
+            std::fabs(result(i) - (2.f * x(i) + y(i) / (1.f + x(i) * x(i)))) < 1e-5f &&
+            std::fabs(root(i) - (std::sqrt(x(i)) - (0.5f - y(i)))) < 1e-5f;
+    }
+
+    EXPECT("value", is_equal);
+}
+
+template <class Kernel>
+bool test_lique_kernel()
+{
+    using namespace trixy::lique::detail;
+
+    // sizes are chosen to hit tails of every register width
+    const std::size_t m = 13, n = 37, k = 300;
+
+    std::vector<float> lhs(m * k), rhs(k * n), x(m * n, 1.f), y(m * n, 1.f);
+    for (std::size_t i = 0; i < lhs.size(); ++i) lhs[i] = float(i % 7) * 0.125f - 0.375f;
+    for (std::size_t i = 0; i < rhs.size(); ++i) rhs[i] = float(i % 5) * 0.25f - 0.5f;
+
+    gemm_packed<Kernel>(m, n, k, lhs.data(), k, 1, rhs.data(), n, 1, x.data(), n, 1);
+    gemm_small(m, n, k, lhs.data(), k, 1, rhs.data(), n, 1, y.data(), n, 1);
+
+    bool is_equal = true;
+    for (std::size_t i = 0; i < x.size(); ++i)
+        is_equal = is_equal && std::fabs(x[i] - y[i]) < 1e-3f;
+
+    float expected = 0.f;
+    for (std::size_t i = 0; i < n; ++i) expected += rhs[i] * rhs[n + i];
+
+    is_equal = is_equal && std::fabs(Kernel::dot(rhs.data(), rhs.data() + n, rhs.data() + n) - expected) < 1e-4f;
+
+    std::vector<float> z(n);
+
+    Kernel::axpy(y.data(), y.data() + n, 2.f, rhs.data());
+    Kernel::assign(z.data(), z.data() + n, mul(), 2.f, rhs.data());
+    Kernel::assign(x.data(), x.data() + n, add(), z.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+        is_equal = is_equal && std::fabs(x[i] - y[i]) < 1e-3f;
+
+    const float sum = Kernel::axpy_dot(y.data(), y.data() + n, 2.f, rhs.data(), rhs.data() + n);
+    Kernel::axpy(x.data(), x.data() + n, 2.f, rhs.data());
+
+    is_equal = is_equal && std::fabs(sum - expected) < 1e-4f;
+    for (std::size_t i = 0; i < n; ++i)
+        is_equal = is_equal && std::fabs(x[i] - y[i]) < 1e-3f;
+
+    // without accumulation the previous values of result are not read
+    std::fill(y.begin(), y.end(), 0.f);
+
+    gemm_packed<Kernel>(m, n, k, lhs.data(), k, 1, rhs.data(), n, 1, x.data(), n, 1, false);
+    gemm_small(m, n, k, lhs.data(), k, 1, rhs.data(), n, 1, y.data(), n, 1);
+
+    for (std::size_t i = 0; i < x.size(); ++i)
+        is_equal = is_equal && std::fabs(x[i] - y[i]) < 1e-3f;
+
+    const float product = Kernel::mul_dot(x.data(), x.data() + n, 2.f, rhs.data(), rhs.data() + n);
+
+    is_equal = is_equal && std::fabs(product - expected) < 1e-4f;
+    for (std::size_t i = 0; i < n; ++i)
+        is_equal = is_equal && x[i] == 2.f * rhs[i];
+
+    // u = 0.5 * u + g, v = v - u / sqrt(1 + u * u), by single pass
+    namespace lazy = trixy::lique::lazy;
+
+    std::vector<float> u(n, 1.f), v(n, 2.f);
+
+    const lazy::Ref<const float> g{ rhs.data(), n };
+    const lazy::Ref<float> ru{ u.data(), n };
+    const lazy::Ref<float> rv{ v.data(), n };
+
+    Kernel::template fuse<float>(0, n, lazy::let(ru, 0.5f * ru + g),
+                                       lazy::let(rv, rv - ru * lazy::rsqrt(1.f + ru * ru)));
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const float value = 0.5f + rhs[i];
+        is_equal = is_equal && std::fabs(u[i] - value) < 1e-6f
+                            && std::fabs(v[i] - (2.f - value / std::sqrt(1.f + value * value))) < 1e-5f;
+    }
+
+    return is_equal;
+}
+
+TEST(TestLique, TestKernelDispatch)
+{
+    using trixy::lique::detail::simd::IsaType;
+    using trixy::lique::detail::simd::Kernel;
+    using trixy::lique::detail::simd::is_supported;
+
+    EXPECT("scalar", test_lique_kernel<Kernel<IsaType::scalar>>());
+
+#ifdef TRIXY_SIMD_X86
+    EXPECT("sse2", test_lique_kernel<Kernel<IsaType::sse2>>());
+
+    if (is_supported(IsaType::avx2)) EXPECT("avx2", test_lique_kernel<Kernel<IsaType::avx2>>());
+    if (is_supported(IsaType::avx512)) EXPECT("avx512", test_lique_kernel<Kernel<IsaType::avx512>>());
+#endif
+}
+
+TEST(TestLique, TestParallelLinear)
+{
+    using ParallelCore = trixy::TypeSet<float, trixy::lique::ParallelLinear>;
+
+    // small thresholds to split even test sized operations between threads
+    ParallelCore::Linear::pool().resize(4);
+    ParallelCore::Linear::setting().min_per_thread = 8;
+    ParallelCore::Linear::setting().min_dot_per_thread = 64;
+
+    ParallelCore::Linear parallel;
+    Core::Linear linear;
+
+    const Core::size_type m = 37;
+    const Core::size_type n = 53;
+    const Core::size_type k = 29;
+
+    Core::precision_type value = 0;
+    auto generator = [&value] { return value = value > 1 ? -1 : value + 0.125f; };
+
+    Core::Matrix lhs(m, k);
+    Core::Matrix rhs(k, n);
+    Core::Matrix wide(2, k);
+    Core::Vector x(m);
+    Core::Vector y(n);
+
+    lhs.fill(generator);
+    rhs.fill(generator);
+    wide.fill(generator);
+    x.fill(generator);
+    y.fill(generator);
+
+    auto is_near_all = [](const Core::Matrix& a, const Core::Matrix& b)
+    {
+        bool is_equal = a.size() == b.size();
+        for (Core::size_type i = 0; is_equal && i < a.size(); ++i)
+            is_equal = std::fabs(a.data()[i] - b.data()[i]) < 1e-3f;
+
+        return is_equal;
+    };
+
+    EXPECT("dot", is_near_all(parallel.dot(lhs, rhs), linear.dot(lhs, rhs)));
+    EXPECT("dot wide", is_near_all(parallel.dot(wide, rhs), linear.dot(wide, rhs)));
+    EXPECT("tensordot",
+        is_near_all(parallel.tensordot<Core::Matrix>(x, x), linear.tensordot<Core::Matrix>(x, x)));
+    EXPECT("transpose", is_near_all(parallel.transpose(lhs), linear.transpose(lhs)));
+
+    Core::Vector row(n);
+    Core::Vector expected_row(n);
+    parallel.dot(row, x, parallel.dot(lhs, rhs));
+    linear.dot(expected_row, x, linear.dot(lhs, rhs));
+
+    Core::Vector col(m);
+    Core::Vector expected_col(m);
+    Core::Matrix product = linear.dot(lhs, rhs);
+    parallel.dot(col, product, y);
+    linear.dot(expected_col, product, y);
+
+    bool is_equal = std::fabs(parallel.dot(y, y) - linear.dot(y, y)) < 1e-3f;
+    for (Core::size_type i = 0; i < n; ++i) is_equal = is_equal && std::fabs(row(i) - expected_row(i)) < 1e-3f;
+    for (Core::size_type i = 0; i < m; ++i) is_equal = is_equal && std::fabs(col(i) - expected_col(i)) < 1e-3f;
+
+    EXPECT("dot vector", is_equal);
+
+    Core::Matrix wide_rhs(k, 600);
+    Core::Vector bias(600);
+    wide_rhs.fill(generator);
+    bias.fill(generator);
+
+    Core::Vector z(600);
+    Core::Vector expected_z(600);
+    Core::Vector h(k);
+    h.fill(generator);
+
+    parallel.dot(z, h, wide_rhs, bias, [&z](Core::size_type first, Core::size_type last)
+    {
+        for (Core::size_type j = first; j < last; ++j) z(j) *= 2.f;
+    });
+
+    linear.dot(expected_z, h, wide_rhs);
+    linear.add(expected_z, bias);
+    linear.join(expected_z, 2.f);
+
+    is_equal = true;
+    for (Core::size_type i = 0; i < 600; ++i) is_equal = is_equal && std::fabs(z(i) - expected_z(i)) < 1e-3f;
+
+    EXPECT("dot bias", is_equal);
+
+    Core::Matrix square(m, m);
+    square.fill(generator);
+    for (Core::size_type i = 0; i < m; ++i) square(i, i) += 4.f;
+
+    Core::Matrix copy = square;
+    Core::Matrix inverse = parallel.inverse(copy);
+    Core::Matrix identity = linear.dot(square, inverse);
+
+    is_equal = true;
+    for (Core::size_type i = 0; i < m; ++i)
+        for (Core::size_type j = 0; j < m; ++j)
+            is_equal = is_equal && std::fabs(identity(i, j) - (i == j ? 1.f : 0.f)) < 1e-3f;
+
+    EXPECT("inverse", is_equal);
+
+    Core::Matrix result(m, k);
+    Core::Matrix expected(m, k);
+
+    parallel.mul(result, lhs, lhs);
+    parallel.sub(result, lhs);
+    parallel.join(result, 0.5f);
+    parallel.apply(result, [](Core::precision_type value) { return value + 1.f; });
+
+    linear.mul(expected, lhs, lhs);
+    linear.sub(expected, lhs);
+    linear.join(expected, 0.5f);
+    linear.apply(expected, [](Core::precision_type value) { return value + 1.f; });
+
+    EXPECT("elementwise", is_near_all(result, expected));
+
+    ParallelCore::Linear::pool().resize(0);
+    ParallelCore::Linear::setting() = trixy::lique::ParallelSetting();
+}
+
 using trixy::set::Input;
 using trixy::set::Output;
 
@@ -112,6 +626,30 @@ TEST(TestNeuro, TestFullyConnected)
             is_near(d(0, 0, 6), 0.65f) &&
             is_near(d(0, 0, 7), -2.1f)
         );
+
+        // curr_delta = idelta * relu'(S) = { -0.5, 0, -0.25, 0.7 }, gradients accumulate until reset
+        layer->backward(input, idelta, false);
+
+        EXPECT("train.gradient",
+            is_near(layer->gradBs_(0), -1.f) && is_near(layer->gradBs_(1), 0.f) &&
+            is_near(layer->gradWs_(1, 0), -2.f) && is_near(layer->gradWs_(1, 3), 2.8f) &&
+            is_near(layer->gradWs_(5, 2), 3.5f) && is_near(layer->gradWs_(7, 1), 0.f)
+        );
+
+        // the first backward after reset overwrites gradients instead of zeroing them before
+        layer->reset();
+        layer->backward(input, idelta, false);
+
+        EXPECT("train.reset",
+            is_near(layer->gradBs_(0), -0.5f) && is_near(layer->gradWs_(1, 0), -1.f) &&
+            is_near(layer->gradWs_(1, 3), 1.4f)
+        );
+
+        // and gradients without backward since reset are read as zeros
+        layer->reset();
+        layer->gradients([](auto&) {});
+
+        EXPECT("train.clear", layer->gradBs_(0) == 0.f && layer->gradWs_(1, 0) == 0.f);
     }
 }
 
@@ -123,7 +661,7 @@ TEST(TestNeuro, TestConvolution)
     {
         auto layer = new XConvolutional(Input(3, 5, 5), Filter(2, 3, 3), Padding(1), Stride(2));
 
-        layer->Ws_[0].copy({
+        layer->W_.copy({
             -1, 1, 1,
             -1, 1, 1,
              0, 0, 1,
@@ -134,10 +672,8 @@ TEST(TestNeuro, TestConvolution)
 
              1, -1, 0,
              -1, 0, -1,
-             0, 1, -1
-        });
+             0, 1, -1,
 
-        layer->Ws_[1].copy({
             0, 0, -1,
             1, 0, 0,
             0, -1, 0,
@@ -193,7 +729,7 @@ TEST(TestNeuro, TestConvolution)
     {
         auto layer = new Convolutional(Input(1, 4, 4), Filter(1, 3, 3));
 
-        layer->Ws_[0].copy({
+        layer->W_.copy({
             1, 4, 1,
             1, 4, 3,
             3, 3, 1
@@ -234,6 +770,68 @@ TEST(TestNeuro, TestConvolution)
             d(0, 2, 0) == 10 && d(0, 2, 1) == 29 && d(0, 2, 2) == 33 && d(0, 2, 3) == 13 &&
             d(0, 3, 0) == 12 && d(0, 3, 1) == 24 && d(0, 3, 2) == 16 && d(0, 3, 3) == 4
         );
+
+        // gradients are written again after reset, not added to the previous ones
+        layer->reset();
+        layer->backward(input, idelta);
+
+        EXPECT("train.gradient",
+            layer->gradB_(0) == 11 && layer->gradW_(0, 0) == 49 && layer->gradW_(0, 8) == 76
+        );
+    }
+
+    {
+        // lowered convolution against direct sums, with padding and different strides
+        Convolutional layer(Input(2, 5, 6), Filter(3, 3, 2), Padding(1), Stride(2, 3));
+
+        const auto& in = layer.isize();
+        const auto& out = layer.osize();
+
+        for (std::size_t i = 0; i < layer.W_.size(); ++i) layer.W_(i) = float(i % 7) - 3.f;
+        for (std::size_t f = 0; f < 3; ++f) layer.B_(f) = float(f);
+
+        Core::Tensor input(in);
+        for (std::size_t i = 0; i < input.size(); ++i) input(i) = float(i % 5) - 2.f;
+
+        Core::Tensor idelta(out);
+        for (std::size_t i = 0; i < idelta.size(); ++i) idelta(i) = float(i % 4) - 1.f;
+
+        layer.forward(input);
+        layer.backward(input, idelta);
+
+        Core::Tensor value(out, 0.f);
+        Core::Tensor delta(in, 0.f);
+        Core::Matrix gradW(layer.W_.shape(), 0.f);
+
+        for (std::size_t f = 0; f < out.depth; ++f)
+            for (std::size_t y = 0; y < out.height; ++y)
+                for (std::size_t x = 0; x < out.width; ++x)
+                {
+                    value(f, y, x) = layer.B_(f);
+
+                    for (std::size_t c = 0; c < in.depth; ++c)
+                        for (std::size_t i = 0; i < 3; ++i)
+                            for (std::size_t j = 0; j < 2; ++j)
+                            {
+                                std::size_t i0 = 2 * y + i - 1;
+                                std::size_t j0 = 3 * x + j - 1;
+
+                                if (i0 >= in.height || j0 >= in.width) continue;
+
+                                std::size_t k = (c * 3 + i) * 2 + j;
+
+                                value(f, y, x) += layer.W_(f, k) * input(c, i0, j0);
+                                gradW(f, k) += idelta(f, y, x) * input(c, i0, j0);
+                                delta(c, i0, j0) += layer.W_(f, k) * idelta(f, y, x);
+                            }
+                }
+
+        bool same = true;
+        for (std::size_t i = 0; i < value.size(); ++i) same = same && value(i) == layer.value()(i);
+        for (std::size_t i = 0; i < delta.size(); ++i) same = same && delta(i) == layer.delta()(i);
+        for (std::size_t i = 0; i < gradW.size(); ++i) same = same && gradW(i) == layer.gradW_(i);
+
+        EXPECT("lowered", same);
     }
 }
 
@@ -261,3 +859,799 @@ TEST(TestNeuro, TestMaxPooling)
         );
     }
 }
+
+// Cos samples of given shape, labeled by three classes in turn
+void make_dataset(trixy::utility::Container<Core::Tensor>& idata, trixy::utility::Container<Core::Tensor>& odata,
+                  std::size_t size, const Input& shape)
+{
+    for (std::size_t n = 0; n < size; ++n)
+    {
+        idata.emplace_back(shape);
+        for (std::size_t i = 0; i < idata.back().size(); ++i) idata.back()(i) = std::cos(0.3f * n + i);
+
+        odata.emplace_back(1, 1, 3, 0.f);
+        odata.back()(n % 3) = 1.f;
+    }
+}
+
+// Networks of the same architecture and step get the same parameters
+void init_net(Net& net, float step = 0.37f)
+{
+    float seed = 0.f;
+    net.init([&seed, step] { seed += step; return std::sin(seed); });
+}
+
+// Convolution, pooling and fully connected layers for samples of shape (1, 4, 4) and three classes
+void build_net(Net& net, FullyConnected::IActivation* activation
+                             = new trixy::functional::activation::Identity<Core::precision_type>,
+               float step = 0.37f)
+{
+    net.add(new Convolutional(Input(1, 4, 4), Filter(2, 3, 3), Padding(1)))
+       .add(new trixy::layer::MaxPooling<Net>(Input(2, 4, 4), Stride(2), new ReLU))
+       .add(new FullyConnected(Input(8), Output(3), activation));
+
+    init_net(net, step);
+}
+
+TEST(TestNeuro, TestBatch)
+{
+    Net net;
+    build_net(net);
+
+    Core::Matrix batch(3, 16);
+    for (std::size_t i = 0; i < batch.size(); ++i) batch(i) = std::cos(0.7f * i);
+
+    Core::Matrix idelta(3, 3);
+    for (std::size_t i = 0; i < idelta.size(); ++i) idelta(i) = 0.1f * i - 0.4f;
+
+    auto& result = net.feedforward_batch(batch);
+
+    bool forward = true;
+    for (std::size_t n = 0; n < 3; ++n)
+    {
+        auto& value = net.feedforward(Core::Tensor(Input(1, 4, 4), batch.data() + n * 16));
+        for (std::size_t j = 0; j < 3; ++j) forward = forward && is_near(value(j), result(n, j));
+    }
+
+    EXPECT("forward", forward);
+
+    auto& fc = static_cast<FullyConnected&>(net.layer(2));
+    auto& pool = static_cast<trixy::layer::MaxPooling<Net>&>(net.layer(1));
+
+    net.feedforward_batch(batch);
+    fc.reset();
+    fc.backward_batch(pool.batch_value(), idelta);
+    pool.backward_batch(net.layer(0).batch_value(), fc.batch_delta());
+
+    Core::Matrix gradWs = fc.gradWs_;
+    Core::Matrix delta = pool.batch_delta();
+
+    fc.reset();
+
+    bool backward = true;
+    for (std::size_t n = 0; n < 3; ++n)
+    {
+        net.feedforward(Core::Tensor(Input(1, 4, 4), batch.data() + n * 16));
+        fc.backward(pool.value(), Core::Tensor(Input(3), idelta.data() + n * 3));
+        pool.backward(net.layer(0).value(), fc.delta());
+
+        for (std::size_t j = 0; j < 32; ++j) backward = backward && is_near(pool.delta()(j), delta(n, j));
+    }
+
+    for (std::size_t i = 0; i < gradWs.size(); ++i) backward = backward && is_near(gradWs(i), fc.gradWs_(i));
+
+    EXPECT("backward", backward);
+}
+
+TEST(TestNeuro, TestDataParallel)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 4, 4));
+
+    Net serial;
+    Net parallel;
+
+    build_net(serial);
+    build_net(parallel);
+
+    trixy::train::Training<Net> serial_teach(serial);
+    trixy::train::Training<Net> parallel_teach(parallel);
+
+    serial_teach.loss(new CCE);
+    parallel_teach.loss(new CCE);
+
+    parallel_teach.pool().resize(3);
+
+    auto serial_optimizer = trixy::train::GradDescentOptimizer(serial, 0.1f);
+    auto parallel_optimizer = trixy::train::GradDescentOptimizer(parallel, 0.1f);
+
+    serial_teach.mini_batch(idata, odata, serial_optimizer, 1, 10);
+    parallel_teach.mini_batch(idata, odata, parallel_optimizer, 1, 10);
+
+    auto near = [](float a, float b) { return std::fabs(a - b) < 1.e-5f; };
+
+    auto& serial_conv = static_cast<Convolutional&>(serial.layer(0));
+    auto& parallel_conv = static_cast<Convolutional&>(parallel.layer(0));
+
+    auto& serial_fc = static_cast<FullyConnected&>(serial.layer(2));
+    auto& parallel_fc = static_cast<FullyConnected&>(parallel.layer(2));
+
+    bool same = true;
+    for (std::size_t i = 0; i < serial_fc.W_.size(); ++i)
+        same = same && near(serial_fc.W_(i), parallel_fc.W_(i));
+
+    for (std::size_t i = 0; i < serial_conv.W_.size(); ++i)
+        same = same && near(serial_conv.W_(i), parallel_conv.W_(i));
+
+    EXPECT("parameters", same && near(serial_conv.B_(0), parallel_conv.B_(0)));
+}
+
+TEST(TestNeuro, TestHogwild)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+    using SoftMax = trixy::functional::activation::SoftMax<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 4, 4));
+
+    Net net;
+    build_net(net, new SoftMax);
+
+    trixy::train::Training<Net> teach(net);
+    teach.loss(new CCE);
+    teach.pool().resize(3);
+
+    auto optimizer = trixy::train::AdamOptimizer(net, 0.01f);
+
+    std::size_t state = 1;
+    auto generator = [&state] { state = state * 1103515245 + 12345; return state >> 16; };
+
+    const auto before = teach.loss(idata, odata);
+    teach.stochastic(idata, odata, optimizer, 3000, generator);
+    const auto after = teach.loss(idata, odata);
+
+    EXPECT("loss", after < before);
+
+    // parameters are shared, but each worker steps own state of optimizer
+    EXPECT("state", optimizer.copies() == 3);
+}
+
+TEST(TestNeuro, TestLocalSGD)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+    using SoftMax = trixy::functional::activation::SoftMax<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 60, Input(1, 4, 4));
+
+    Net net;
+    build_net(net, new SoftMax);
+
+    trixy::train::Training<Net> teach(net);
+    teach.loss(new CCE);
+    teach.pool().resize(3);
+
+    auto optimizer = trixy::train::AdamOptimizer(net, 0.01f);
+
+    const auto before = teach.loss(idata, odata);
+    teach.local_mini_batch(idata, odata, optimizer, 50, 5, 2);
+    const auto after = teach.loss(idata, odata);
+
+    EXPECT("loss", after < before);
+}
+
+TEST(TestNeuro, TestFlat)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 4, 4));
+
+    Net scattered;
+    Net flat;
+
+    build_net(scattered);
+    build_net(flat);
+
+    trixy::train::Training<Net> scattered_teach(scattered);
+    trixy::train::Training<Net> flat_teach(flat);
+
+    scattered_teach.loss(new CCE);
+    flat_teach.loss(new CCE);
+
+    flat_teach.flatten();
+
+    auto& flat_conv = static_cast<Convolutional&>(flat.layer(0));
+    auto& flat_fc = static_cast<FullyConnected&>(flat.layer(2));
+
+    auto first = flat_teach.flat_parameters().data();
+    auto last = first + flat_teach.flat_parameters().size();
+
+    bool is_view = flat_fc.W_.data() > first && flat_fc.W_.data() < last
+                && flat_conv.B_.data() > first && flat_conv.B_.data() < last;
+
+    auto address = reinterpret_cast<std::uintptr_t>(flat_fc.W_.data());
+
+    EXPECT("layout", flat_teach.is_flat() && is_view && address % trixy::detail::alignment == 0
+                     && flat_teach.flat_gradients().size() == flat_teach.flat_parameters().size());
+
+    auto scattered_optimizer = trixy::train::GradDescentOptimizer(scattered, 0.1f);
+    auto flat_optimizer = trixy::train::GradDescentOptimizer(flat, 0.1f);
+
+    scattered_teach.mini_batch(idata, odata, scattered_optimizer, 2, 10);
+    flat_teach.mini_batch(idata, odata, flat_optimizer, 2, 10);
+
+    flat_teach.unflatten();
+
+    auto& scattered_conv = static_cast<Convolutional&>(scattered.layer(0));
+    auto& scattered_fc = static_cast<FullyConnected&>(scattered.layer(2));
+
+    // tails of tensors are updated by scalar code, which may be not contracted to fma as simd body is
+    bool same = not flat_teach.is_flat();
+    for (std::size_t i = 0; i < scattered_fc.W_.size(); ++i)
+        same = same && is_near(scattered_fc.W_(i), flat_fc.W_(i));
+
+    for (std::size_t i = 0; i < scattered_conv.W_.size(); ++i)
+        same = same && is_near(scattered_conv.W_(i), flat_conv.W_(i));
+
+    EXPECT("parameters", same && is_near(scattered_conv.B_(0), flat_conv.B_(0)));
+
+    // bias correction of Adam counts steps, not calls of update, so both layouts train the same
+    Net scattered_adam;
+    Net flat_adam;
+
+    build_net(scattered_adam);
+    build_net(flat_adam);
+
+    trixy::train::Training<Net> scattered_adam_teach(scattered_adam);
+    trixy::train::Training<Net> flat_adam_teach(flat_adam);
+
+    scattered_adam_teach.loss(new CCE);
+    flat_adam_teach.loss(new CCE);
+
+    flat_adam_teach.flatten();
+
+    auto scattered_adam_optimizer = trixy::train::AdamOptimizer(scattered_adam, 0.01f);
+    auto flat_adam_optimizer = trixy::train::AdamOptimizer(flat_adam, 0.01f);
+
+    scattered_adam_teach.mini_batch(idata, odata, scattered_adam_optimizer, 3, 10);
+    flat_adam_teach.mini_batch(idata, odata, flat_adam_optimizer, 3, 10);
+
+    flat_adam_teach.unflatten();
+
+    auto& scattered_adam_fc = static_cast<FullyConnected&>(scattered_adam.layer(2));
+    auto& flat_adam_fc = static_cast<FullyConnected&>(flat_adam.layer(2));
+
+    bool near = true;
+    for (std::size_t i = 0; i < scattered_adam_fc.W_.size(); ++i)
+        near = near && is_near(scattered_adam_fc.W_(i), flat_adam_fc.W_(i));
+
+    EXPECT("adam", near);
+}
+
+TEST(TestNeuro, TestOptimizerState)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 1, 6));
+
+    auto build = [](Net& net)
+    {
+        net.add(new FullyConnected(Input(6), Output(5), new ReLU))
+           .add(new FullyConnected(Input(5), Output(3)));
+
+        init_net(net);
+    };
+
+    Net expected;
+    Net moved;
+
+    build(expected);
+    build(moved);
+
+    trixy::train::Training<Net> expected_teach(expected);
+    trixy::train::Training<Net> moved_teach(moved);
+
+    expected_teach.loss(new CCE);
+    moved_teach.loss(new CCE);
+
+    auto expected_optimizer = trixy::train::MomentumOptimizer(expected, 0.1f);
+    auto moved_optimizer = trixy::train::MomentumOptimizer(moved, 0.1f);
+
+    EXPECT("slots", moved_optimizer.slot_count() == 5 && moved_optimizer.flat_slot() == 4);
+
+    expected_teach.mini_batch(idata, odata, expected_optimizer, 2, 10);
+
+    // velocity is kept by slot, while parameters are moved to the flat buffer
+    moved_teach.mini_batch(idata, odata, moved_optimizer, 1, 10);
+    moved_teach.flatten();
+    moved_teach.mini_batch(idata, odata, moved_optimizer, 1, 10);
+    moved_teach.unflatten();
+
+    auto near = [](float a, float b) { return std::fabs(a - b) < 1.e-5f; };
+
+    auto& expected_fc = static_cast<FullyConnected&>(expected.layer(0));
+    auto& moved_fc = static_cast<FullyConnected&>(moved.layer(0));
+
+    bool same = true;
+    for (std::size_t i = 0; i < expected_fc.W_.size(); ++i)
+        same = same && near(expected_fc.W_(i), moved_fc.W_(i));
+
+    EXPECT("parameters", same);
+}
+
+TEST(TestNeuro, TestOptimizer)
+{
+    Net net;
+    net.add(new FullyConnected(Input(5), Output(7)));
+
+    auto adam = trixy::train::AdamOptimizer(net, 0.01f);
+    auto nestorov = trixy::train::NestorovOptimizer(net, 0.1f, 0.9f);
+
+    // the whole network: 7 biases and 35 weights with padding
+    trixy::utility::Container<Core::Vector> params;
+    trixy::utility::Container<Core::Vector> grads;
+
+    for (std::size_t k = 0; k < 2; ++k)
+    {
+        params.emplace_back(64);
+        grads.emplace_back(64);
+
+        float value = 0.f;
+        params.back().fill([&value] { return value += 0.125f; });
+        grads.back().fill([&value] { return value = -0.75f * value + 0.5f; });
+    }
+
+    const Core::Vector w(params[0]);
+    const Core::Vector g(grads[0]);
+
+    for (std::size_t t = 0; t < 2; ++t)
+    {
+        adam.update(adam.flat_slot(), params[0], grads[0]);
+        nestorov.update(nestorov.flat_slot(), params[1], grads[1]);
+    }
+
+    bool is_equal = adam.flat_slot() == 2 && params[0].size() == 64;
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        // reference of two steps with the same gradient
+        float m = 0.f, s = 0.f, v = 0.f;
+        float x = w(i), y = w(i);
+
+        for (int t = 1; t <= 2; ++t)
+        {
+            m = 0.9f * m + 0.1f * g(i);
+            s = 0.999f * s + 0.001f * g(i) * g(i);
+            x -= 0.01f / (1.f - std::pow(0.9f, t)) * m / std::sqrt(1e-9f + s / (1.f - std::pow(0.999f, t)));
+
+            v = 0.9f * v - 0.1f * g(i);
+            y += 0.9f * v - 0.1f * g(i);
+        }
+
+        is_equal = is_equal && std::fabs(params[0](i) - x) < 1e-5f && std::fabs(params[1](i) - y) < 1e-5f;
+    }
+
+    EXPECT("update", is_equal);
+}
+
+TEST(TestNeuro, TestQuantizedOptimizer)
+{
+    Net net;
+    net.add(new FullyConnected(Input(300), Output(3)));
+
+    auto adam = trixy::train::AdamOptimizer(net, 0.01f);
+    auto adam8 = trixy::train::Adam8Optimizer(net, 0.01f);
+
+    // biases and weights, where block of weights is not full
+    const std::size_t sizes[2] = { 3, 900 };
+
+    bool is_equal = true;
+    for (std::size_t slot = 0; slot < 2; ++slot)
+    {
+        const std::size_t n = sizes[slot];
+
+        Core::Vector w(n), w8(n), g(n);
+
+        float value = 0.f;
+        w.fill([&value] { return value += 0.001f; });
+        g.fill([&value] { return value = -0.75f * value + 0.5f; });
+        w8.copy(w);
+
+        for (std::size_t t = 0; t < 3; ++t)
+        {
+            adam.update(slot, w, g);
+            adam8.update(slot, w8, g);
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            is_equal = is_equal && std::fabs(w(i) - w8(i)) < 1e-3f;
+    }
+
+    EXPECT("update", is_equal);
+}
+
+TEST(TestNeuro, TestLayerwiseOptimizer)
+{
+    Net net;
+    net.add(new FullyConnected(Input(5), Output(3)));
+
+    auto lamb = trixy::train::LAMBOptimizer(net, 0.01f, 0.1f);
+    auto lars = trixy::train::LARSOptimizer(net, 0.1f, 0.9f, 0.1f);
+    auto flat_lamb = trixy::train::LAMBOptimizer(net, 0.01f, 0.1f);
+    auto flat_lars = trixy::train::LARSOptimizer(net, 0.1f, 0.9f, 0.1f);
+
+    // biases at 0, weights at padded offset
+    const std::size_t offset = trixy::detail::padded<float>(3);
+    const std::size_t sizes[2] = { 3, 15 };
+
+    Core::Vector w(offset + 15), g(offset + 15);
+
+    float value = 0.f;
+    w.fill([&value] { return value += 0.125f; });
+    g.fill([&value] { return value = -0.75f * value + 0.5f; });
+
+    Core::Vector w_lamb(w), w_lars(w), w_flat_lamb(w), w_flat_lars(w);
+
+    bool is_equal = true;
+    for (std::size_t t = 0; t < 2; ++t)
+    {
+        for (std::size_t slot = 0; slot < 2; ++slot)
+        {
+            using Range = trixy::utility::Range<float>;
+
+            const std::size_t first = slot == 0 ? 0 : offset;
+            const Range gs(g.data() + first, g.data() + first + sizes[slot]);
+
+            lamb.update(slot, Range(w_lamb.data() + first, w_lamb.data() + first + sizes[slot]), gs);
+            lars.update(slot, Range(w_lars.data() + first, w_lars.data() + first + sizes[slot]), gs);
+        }
+
+        flat_lamb.update(flat_lamb.flat_slot(), w_flat_lamb, g);
+        flat_lars.update(flat_lars.flat_slot(), w_flat_lars, g);
+    }
+
+    for (std::size_t slot = 0; slot < 2; ++slot)
+    {
+        const std::size_t first = slot == 0 ? 0 : offset;
+        const std::size_t n = sizes[slot];
+
+        // reference of two steps with the same gradient, the first one has zero moments and velocity
+        std::vector<float> m(n, 0.f), s(n, 0.f), v(n, 0.f), x(n), y(n);
+        for (std::size_t i = 0; i < n; ++i) x[i] = y[i] = w(first + i);
+
+        for (int t = 1; t <= 2; ++t)
+        {
+            float x_norm = 0.f, r_norm = 0.f, y_norm = 0.f, g_norm = 0.f;
+            std::vector<float> r(n);
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const float gi = g(first + i);
+
+                m[i] = 0.9f * m[i] + 0.1f * gi;
+                s[i] = 0.999f * s[i] + 0.001f * gi * gi;
+
+                r[i] = m[i] / (1.f - std::pow(0.9f, t)) / std::sqrt(1e-9f + s[i] / (1.f - std::pow(0.999f, t)))
+                     + 0.1f * x[i];
+
+                x_norm += x[i] * x[i];
+                r_norm += r[i] * r[i];
+                y_norm += y[i] * y[i];
+                g_norm += gi * gi;
+            }
+
+            const float lamb_rate = 0.01f * std::sqrt(x_norm) / std::sqrt(r_norm);
+            const float lars_rate = 0.1f * 0.001f * std::sqrt(y_norm) / (std::sqrt(g_norm) + 0.1f * std::sqrt(y_norm));
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                x[i] -= lamb_rate * r[i];
+
+                v[i] = 0.9f * v[i] + lars_rate * (g(first + i) + 0.1f * y[i]);
+                y[i] -= v[i];
+            }
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            is_equal = is_equal && std::fabs(w_lamb(first + i) - x[i]) < 1e-5f
+                                && std::fabs(w_lars(first + i) - y[i]) < 1e-6f
+                                && w_flat_lamb(first + i) == w_lamb(first + i)
+                                && w_flat_lars(first + i) == w_lars(first + i);
+        }
+    }
+
+    EXPECT("update", is_equal);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <unistd.h> // fork, getpid, _exit
+#include <sys/wait.h> // waitpid
+
+// Runs function(rank) in size processes, rank 0 is the current one
+template <class Function>
+bool run_ranks(std::size_t size, Function function)
+{
+    std::vector<pid_t> children;
+    for (std::size_t rank = 1; rank < size; ++rank)
+    {
+        pid_t pid = fork();
+        if (pid == 0) _exit(function(rank) ? 0 : 1);
+
+        children.push_back(pid);
+    }
+
+    bool result = function(0);
+    for (auto pid : children)
+    {
+        int status = 0;
+        waitpid(pid, &status, 0);
+
+        result = result && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    return result;
+}
+
+TEST(TestDistributed, TestAllreduce)
+{
+    const std::size_t size = 3;
+    const std::string name = "trixy-test-" + std::to_string(getpid());
+
+    auto check = [size](trixy::distributed::ICommunicator& communicator)
+    {
+        if (not communicator.is_open()) return false;
+
+        std::vector<float> data(1001);
+        for (std::size_t i = 0; i < data.size(); ++i) data[i] = float(communicator.rank() + i);
+
+        communicator.allreduce(data.data(), data.size());
+
+        bool ok = true;
+        for (std::size_t i = 0; i < data.size(); ++i)
+            ok = ok && data[i] == float(size * i + size * (size - 1) / 2);
+
+        std::vector<char> block(300, char(communicator.rank()));
+        std::vector<char> blocks(size * block.size());
+
+        communicator.allgather(block.data(), block.size(), blocks.data());
+
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            ok = ok && blocks[i] == char(i / block.size());
+
+        communicator.barrier();
+        return ok;
+    };
+
+    // segment of crashed run with garbage in barrier counters
+    pid_t crashed = fork();
+    if (crashed == 0)
+    {
+        trixy::distributed::SharedSegment segment("/" + name, 64 + size * 256, true);
+        for (std::size_t i = 0; i < 64; ++i) segment.data()[i] = char(1);
+
+        segment.ready();
+        _exit(0);
+    }
+
+    waitpid(crashed, nullptr, 0);
+
+    EXPECT("shared memory", run_ranks(size, [&](std::size_t rank)
+    {
+        // small slot, so data is reduced by several pieces
+        trixy::distributed::SharedMemoryCommunicator communicator("/" + name, rank, size, 256);
+        return check(communicator);
+    }));
+
+    EXPECT("socket", run_ranks(size, [&](std::size_t rank)
+    {
+        trixy::distributed::SocketCommunicator communicator("/tmp/" + name, rank, size);
+        return check(communicator);
+    }));
+
+    EXPECT("socket lost", run_ranks(2, [&](std::size_t rank)
+    {
+        // the second rank leaves as soon as the ring is connected
+        trixy::distributed::SocketCommunicator communicator("/tmp/" + name + "-lost", rank, 2);
+        if (rank == 1) return communicator.is_open();
+
+        std::vector<float> data(1 << 16, 1.f);
+        communicator.allreduce(data.data(), data.size());
+
+        return not communicator.is_open();
+    }));
+
+    // the last rank never starts, so the others give up on it after timeout
+    EXPECT("shared memory absent", run_ranks(2, [&](std::size_t rank)
+    {
+        if (rank == 1) return true;
+
+        trixy::distributed::SharedMemoryCommunicator communicator("/" + name + "-absent", rank, 2, 256, 200);
+        return not communicator.is_open();
+    }));
+
+    EXPECT("socket absent", run_ranks(3, [&](std::size_t rank)
+    {
+        if (rank == 2) return true;
+
+        trixy::distributed::SocketCommunicator communicator("/tmp/" + name + "-absent", rank, 3, 200);
+        return not communicator.is_open();
+    }));
+}
+
+TEST(TestDistributed, TestCompressor)
+{
+    std::vector<float> data(100);
+    for (std::size_t i = 0; i < data.size(); ++i) data[i] = std::sin(0.7f * i) * float(i);
+
+    auto roundtrip = [&data](trixy::distributed::ICompressor<float>& compressor)
+    {
+        std::vector<char> payload(compressor.capacity(data.size()));
+
+        compressor.reserve(data.size());
+        compressor.compress(data.data(), data.size(), payload.data());
+
+        std::vector<float> result(data.size(), 0.f);
+        compressor.decompress(payload.data(), data.size(), result.data());
+
+        return result;
+    };
+
+    trixy::distributed::TopKCompressor<float> topk(0.1);
+    trixy::distributed::Int8Compressor<float> int8;
+    trixy::distributed::SignCompressor<float> sign;
+
+    auto sparse = roundtrip(topk);
+
+    std::size_t kept = 0;
+    float smallest_kept = 1.e9f, largest_dropped = 0.f;
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        if (sparse[i] != 0.f) { ++kept; smallest_kept = std::min(smallest_kept, std::fabs(data[i])); }
+        else largest_dropped = std::max(largest_dropped, std::fabs(data[i]));
+    }
+
+    EXPECT("top-k", kept == 10 && smallest_kept >= largest_dropped && topk.capacity(100) == 80);
+
+    // empty bucket has empty payload
+    topk.compress(data.data(), 0, nullptr);
+    EXPECT("top-k empty", topk.capacity(0) == 0);
+
+    auto quantized = roundtrip(int8);
+
+    bool near = true;
+    for (std::size_t i = 0; i < data.size(); ++i) near = near && std::fabs(quantized[i] - data[i]) <= 99.f / 254.f;
+
+    EXPECT("8-bit", near && int8.capacity(100) == 104);
+
+    auto signs = roundtrip(sign);
+
+    bool same_sign = true;
+    for (std::size_t i = 0; i < data.size(); ++i) same_sign = same_sign && (signs[i] >= 0.f) == (data[i] >= 0.f);
+
+    EXPECT("1-bit", same_sign && sign.capacity(100) == 17);
+}
+
+TEST(TestDistributed, TestMiniBatch)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+    using SoftMax = trixy::functional::activation::SoftMax<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 4, 4));
+
+    const std::string name = "/trixy-test-" + std::to_string(getpid());
+
+    Net serial;
+    build_net(serial, new SoftMax);
+
+    trixy::train::Training<Net> serial_teach(serial);
+    serial_teach.loss(new CCE);
+
+    auto serial_optimizer = trixy::train::GradDescentOptimizer(serial, 0.1f);
+    serial_teach.mini_batch(idata, odata, serial_optimizer, 2, 10);
+
+    EXPECT("parameters", run_ranks(2, [&](std::size_t rank)
+    {
+        // parameters of rank 0 are broadcast to the others
+        Net net;
+        build_net(net, new SoftMax, rank == 0 ? 0.37f : 0.11f);
+
+        trixy::distributed::SharedMemoryCommunicator communicator(name, rank, 2);
+        if (not communicator.is_open()) return false;
+
+        trixy::train::Training<Net> teach(net);
+        teach.loss(new CCE);
+        teach.communicator(&communicator);
+
+        auto optimizer = trixy::train::GradDescentOptimizer(net, 0.1f);
+        teach.mini_batch(idata, odata, optimizer, 2, 10);
+
+        teach.communicator(nullptr);
+
+        auto near = [](float a, float b) { return std::fabs(a - b) < 1.e-5f; };
+
+        auto& fc = static_cast<FullyConnected&>(net.layer(2));
+        auto& serial_fc = static_cast<FullyConnected&>(serial.layer(2));
+
+        bool same = true;
+        for (std::size_t i = 0; i < fc.W_.size(); ++i) same = same && near(fc.W_(i), serial_fc.W_(i));
+
+        return same;
+    }));
+}
+
+TEST(TestDistributed, TestParameterServer)
+{
+    using CCE = trixy::functional::loss::CCE<Core::precision_type>;
+    using SoftMax = trixy::functional::activation::SoftMax<Core::precision_type>;
+
+    trixy::utility::Container<Core::Tensor> idata;
+    trixy::utility::Container<Core::Tensor> odata;
+
+    make_dataset(idata, odata, 30, Input(1, 4, 4));
+
+    const std::string name = "/trixy-test-" + std::to_string(getpid());
+    const std::size_t workers = 2;
+
+    // segment of crashed run: its server has stopped and never removed it
+    pid_t crashed = fork();
+    if (crashed == 0)
+    {
+        trixy::distributed::ParameterChannel<float> channel(name, workers, workers, 1 << 12);
+        channel.stop();
+        _exit(0);
+    }
+
+    waitpid(crashed, nullptr, 0);
+
+    EXPECT("loss", run_ranks(workers + 1, [&](std::size_t rank)
+    {
+        Net net;
+        build_net(net, new SoftMax);
+
+        trixy::train::Training<Net> teach(net);
+        teach.loss(new CCE);
+
+        // rank 0 is server, the others are workers
+        const std::size_t worker = rank == 0 ? workers : rank - 1;
+        trixy::distributed::ParameterChannel<float> channel(name, worker, workers, teach.parameter_count());
+
+        if (not channel.is_open()) return false;
+
+        if (rank == 0)
+        {
+            auto optimizer = trixy::train::GradDescentOptimizer(net, 0.1f);
+
+            const auto before = teach.loss(idata, odata);
+            teach.parameter_server(channel, optimizer, 200, 4);
+            const auto after = teach.loss(idata, odata);
+
+            return after < before;
+        }
+
+        std::size_t state = rank;
+        auto generator = [&state] { state = state * 1103515245 + 12345; return state >> 16; };
+
+        teach.parameter_worker(channel, worker, idata, odata, 5, generator);
+        return true;
+    }));
+}
+
+#endif
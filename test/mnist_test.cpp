@@ -11,6 +11,14 @@
 #include <iomanip> // setprecision, fixed
 #include <fstream> // ifstream, ofstream
 #include <vector> // vector
+#include <thread> // hardware_concurrency
+#include <string> // string, to_string
+#include <utility> // pair
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h> // fork, getpid, _exit
+    #include <sys/wait.h> // waitpid
+#endif
 
 using Core = trixy::TypeSet<float>;
 using Net = trixy::TrixyNet<Core>;
@@ -204,6 +212,184 @@ void mnist_test()
     std::cout << "End of serialization\n";
 }
 
+// Convergence of lock-free stochastic training against number of threads
+void mnist_test_hogwild()
+{
+    auto dataset = mnist::read_dataset("mnist");
+
+    Core::size_type train_batch_size = 60000; // max 60 000
+    Core::size_type test_batch_size  = 10000;
+    Core::size_type input_size  = 784;
+    Core::size_type output_size = 10;
+
+    auto train_idata = get_idata(dataset.training_images, train_batch_size, input_size);
+    auto train_odata = get_odata(dataset.training_labels, train_batch_size, output_size);
+
+    auto test_idata = get_idata(dataset.test_images, test_batch_size, input_size);
+    auto test_odata = get_odata(dataset.test_labels, test_batch_size, output_size);
+
+    const Core::size_type max_threads = std::thread::hardware_concurrency();
+
+    for (Core::size_type threads = 1; threads <= max_threads; threads *= 2)
+    {
+        trixy::utility::RandomFloating<Core::precision_type> random;
+        auto generator = [&random] { return random(-0.25f, 0.25f); };
+
+        trixy::utility::RandomIntegral<Core::size_type> index;
+
+        Net net;
+
+        net.add(new FullyConnected(input_size, 256, new ReLU))
+           .add(new FullyConnected(256, output_size, new SoftMax));
+
+        net.init(generator);
+
+        trixy::train::Training<Net> teach(net);
+        trixy::Checker<Net> check(net);
+
+        teach.loss(new CCE);
+        teach.pool().resize(threads);
+
+        auto optimizer = trixy::train::GradDescentOptimizer(net, 0.01f);
+
+        Timer t;
+        teach.stochastic(train_idata, train_odata, optimizer, train_batch_size, index);
+
+        std::cout << "Hogwild threads: " << threads
+                  << " train time: " << t.elapsed()
+                  << " test set accuracy: " << check.accuracy(test_idata, test_odata) << '\n';
+    }
+}
+
+// Throughput and accuracy of local SGD against period of model averaging
+void mnist_test_local_sgd()
+{
+    auto dataset = mnist::read_dataset("mnist");
+
+    Core::size_type train_batch_size = 60000; // max 60 000
+    Core::size_type test_batch_size  = 10000;
+    Core::size_type input_size  = 784;
+    Core::size_type output_size = 10;
+
+    auto train_idata = get_idata(dataset.training_images, train_batch_size, input_size);
+    auto train_odata = get_odata(dataset.training_labels, train_batch_size, output_size);
+
+    auto test_idata = get_idata(dataset.test_images, test_batch_size, input_size);
+    auto test_odata = get_odata(dataset.test_labels, test_batch_size, output_size);
+
+    for (Core::size_type period : { 1, 4, 16, 64 })
+    {
+        trixy::utility::RandomFloating<Core::precision_type> random;
+        auto generator = [&random] { return random(-0.25f, 0.25f); };
+
+        Net net;
+
+        net.add(new FullyConnected(input_size, 256, new ReLU))
+           .add(new FullyConnected(256, output_size, new SoftMax));
+
+        net.init(generator);
+
+        trixy::train::Training<Net> teach(net);
+        trixy::Checker<Net> check(net);
+
+        teach.loss(new CCE);
+        teach.pool().resize(std::thread::hardware_concurrency());
+
+        auto optimizer = trixy::train::AdamOptimizer(net, 0.01f);
+
+        Timer t;
+        teach.local_mini_batch(train_idata, train_odata, optimizer, 1, 10, period);
+
+        std::cout << "Local SGD period: " << period
+                  << " train time: " << t.elapsed()
+                  << " test set accuracy: " << check.accuracy(test_idata, test_odata) << '\n';
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Bytes sent per step and time per step of compressed gradient exchange between 2 processes
+void mnist_test_compression()
+{
+    auto dataset = mnist::read_dataset("mnist");
+
+    Core::size_type train_batch_size = 60000; // max 60 000
+    Core::size_type test_batch_size  = 10000;
+    Core::size_type input_size  = 784;
+    Core::size_type output_size = 10;
+    Core::size_type mini_batch_size = 100;
+
+    auto train_idata = get_idata(dataset.training_images, train_batch_size, input_size);
+    auto train_odata = get_odata(dataset.training_labels, train_batch_size, output_size);
+
+    auto test_idata = get_idata(dataset.test_images, test_batch_size, input_size);
+    auto test_odata = get_odata(dataset.test_labels, test_batch_size, output_size);
+
+    trixy::distributed::TopKCompressor<Core::precision_type> topk(0.01);
+    trixy::distributed::Int8Compressor<Core::precision_type> int8;
+    trixy::distributed::SignCompressor<Core::precision_type> sign;
+
+    std::vector<std::pair<const char*, trixy::distributed::ICompressor<Core::precision_type>*>> compressors
+    {
+        { "none", nullptr }, { "top-k 1%", &topk }, { "8-bit", &int8 }, { "1-bit", &sign }
+    };
+
+    for (auto& compressor : compressors)
+    {
+        const std::string name = "/trixy-mnist-" + std::to_string(getpid());
+
+        // communicator is closed by both processes at the end of run
+        auto run = [&](Core::size_type rank)
+        {
+            trixy::utility::RandomFloating<Core::precision_type> random;
+            auto generator = [&random] { return random(-0.25f, 0.25f); };
+
+            Net net;
+
+            net.add(new FullyConnected(input_size, 256, new ReLU))
+               .add(new FullyConnected(256, output_size, new SoftMax));
+
+            net.init(generator);
+
+            trixy::distributed::SharedMemoryCommunicator communicator(name, rank, 2);
+
+            trixy::train::Training<Net> teach(net);
+            trixy::Checker<Net> check(net);
+
+            teach.loss(new CCE);
+            teach.communicator(&communicator, compressor.second);
+
+            auto optimizer = trixy::train::GradDescentOptimizer(net, 0.1f);
+
+            Timer t;
+            teach.mini_batch(train_idata, train_odata, optimizer, 1, mini_batch_size);
+
+            const auto steps = train_batch_size / mini_batch_size;
+            const auto time = t.elapsed();
+
+            if (rank == 0)
+                std::cout << "Compression: " << compressor.first
+                          << " bytes per step: " << teach.reducer()->bytes() / steps
+                          << " time per step: " << time / steps
+                          << " test set accuracy: " << check.accuracy(test_idata, test_odata) << '\n';
+
+            teach.communicator(nullptr);
+        };
+
+        pid_t child = fork();
+        if (child == 0)
+        {
+            run(1);
+            _exit(0);
+        }
+
+        run(0);
+        waitpid(child, nullptr, 0);
+    }
+}
+
+#endif
+
 TEST(TestExample, TestMNIST)
 {
     sf::serializable<FullyConnected>();
@@ -214,4 +400,11 @@ TEST(TestExample, TestMNIST)
 
     mnist_test();
     mnist_test_deserialization();
+
+    mnist_test_hogwild();
+    mnist_test_local_sgd();
+
+#if defined(__unix__) || defined(__APPLE__)
+    mnist_test_compression();
+#endif
 }